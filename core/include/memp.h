@@ -0,0 +1,107 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_memp Memory pools
+ * @ingroup     core
+ * @brief       Fixed-size block memory pools
+ *
+ * A pool hands out blocks of one fixed size from a caller supplied buffer.
+ * Free blocks are kept in a singly linked free list threaded through the
+ * blocks themselves, so allocation and release take constant time and need
+ * no extra memory per block.
+ *
+ * All pool functions briefly disable interrupts and can be used from thread
+ * and interrupt context alike.
+ *
+ * Every initialized pool keeps statistics (blocks in use, high-water mark,
+ * failed allocations) and is registered in a global list, so the usage of all
+ * pools can be printed in one place with @ref memp_print_stats.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Memory pool API
+ */
+
+#ifndef MEMP_H
+#define MEMP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size a block of @p size bytes occupies in the pool buffer
+ *
+ * Blocks are rounded up to a multiple of the pointer size, so the free list
+ * pointer stored in a free block is always aligned.
+ */
+#define MEMP_BLOCK_SIZE(size)   (((size) + sizeof(void *) - 1) & \
+                                 ~(sizeof(void *) - 1))
+
+/**
+ * @brief   Memory pool struct definition
+ */
+typedef struct memp {
+    struct memp *next;      /**< next pool in the list of pools */
+    const char *name;       /**< name of the pool, for statistics */
+    void *free;             /**< head of the free list */
+    uint16_t numof;         /**< total number of blocks */
+    uint16_t used;          /**< number of blocks in use */
+    uint16_t high_water;    /**< maximum number of blocks in use at once */
+    uint16_t failures;      /**< number of failed allocations */
+} memp_t;
+
+/**
+ * @brief   Initialize a pool and register it for statistics
+ *
+ * @pre @p buf is aligned for a pointer and at least
+ *      @p numof * MEMP_BLOCK_SIZE(@p block_size) bytes large
+ *
+ * @param[out] pool         pool to initialize
+ * @param[in] name          name of the pool, shown by @ref memp_print_stats
+ * @param[in] buf           memory the blocks are carved from
+ * @param[in] block_size    size of a single block in bytes
+ * @param[in] numof         number of blocks
+ */
+void memp_init(memp_t *pool, const char *name, void *buf, size_t block_size,
+               unsigned numof);
+
+/**
+ * @brief   Allocate a block from a pool
+ *
+ * @param[in] pool  pool to allocate from
+ *
+ * @return  pointer to the block
+ * @return  NULL, if all blocks are in use
+ */
+void *memp_alloc(memp_t *pool);
+
+/**
+ * @brief   Return a block to its pool
+ *
+ * @pre @p block was allocated from @p pool and is not already free
+ *
+ * @param[in] pool  pool @p block was allocated from
+ * @param[in] block block to release, may be NULL
+ */
+void memp_free(memp_t *pool, void *block);
+
+/**
+ * @brief   Print the statistics of all initialized pools to stdout
+ */
+void memp_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMP_H */
+/** @} */
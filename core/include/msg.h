@@ -272,6 +272,27 @@ int msg_send_to_self(msg_t *m);
  */
 int msg_send_int(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send several messages to a thread at once, non-blocking.
+ *
+ * Delivers the messages in @p m in order, as if msg_try_send() was called
+ * for each of them, but disables interrupts only once and causes at most one
+ * context switch for the whole batch. If the target is waiting in
+ * msg_receive(), the first message is handed over directly, the following
+ * ones are put into the target's message queue as long as it has room.
+ *
+ * Can be called from interrupt context, ``sender_pid`` is then set to
+ * @ref KERNEL_PID_ISR.
+ *
+ * @param[in] m             Array of @p num messages, must not be NULL.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return number of messages delivered, the first ones of @p m
+ * @return -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 /**
  * @brief Test if the message was sent inside an ISR.
  * @see msg_send_int()
@@ -296,6 +317,24 @@ static inline int msg_sent_by_int(const msg_t *m)
  */
 int msg_receive(msg_t *m);
 
+/**
+ * @brief Receive several messages at once.
+ *
+ * Blocks until at least one message is available, then takes up to @p num
+ * messages from the message queue and from threads waiting to send to this
+ * thread within one critical section. If @p num is reached, the messages of
+ * threads still waiting to send are moved into the freed queue space, as
+ * msg_receive() does. Threads waiting to send are woken up with at most one
+ * context switch.
+ *
+ * @param[out] m    Array of at least @p num ``msg_t`` structures, must not
+ *                  be NULL.
+ * @param[in] num   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  number of messages received (1 to @p num).
+ */
+int msg_receive_bulk(msg_t *m, unsigned num);
+
 /**
  * @brief Try to receive a message.
  *
@@ -315,6 +354,11 @@ int msg_try_receive(msg_t *m);
  * This function sends a message to *target_pid* and then blocks until target
  * has sent a reply which is then stored in *reply*.
  *
+ * If the target is already waiting in msg_receive(), the message is handed
+ * over directly and the target is scheduled in front of other runnable
+ * threads of its priority, i.e. it continues on the time the caller gave up.
+ * msg_reply() does the same for the way back.
+ *
  * @pre     @p target_pid is not the PID of the current thread.
  *
  * @param[in] m             Pointer to preallocated ``msg_t`` structure with
@@ -332,6 +376,9 @@ int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid);
  *
  * Sender must have sent the message with msg_send_receive().
  *
+ * If the sender's priority is not lower than the one of the current thread,
+ * the current thread yields and the sender continues immediately.
+ *
  * @param[in] m         message to reply to, must not be NULL.
  * @param[out] reply    message that target will get as reply, must not be NULL.
  *
@@ -13,6 +13,22 @@
  * @ingroup     core
  * @{
  *
+ * Priority inheritance
+ * ====================
+ *
+ * With the module `core_mutex_priority_inheritance`, a thread holding a mutex
+ * that is blocked on by a thread of higher priority temporarily runs at the
+ * priority of the blocked thread, until it unlocks the mutex. This bounds the
+ * time a high priority thread is delayed by a thread of medium priority
+ * preempting a low priority lock owner. Recursive mutexes (@ref rmutex_t) and
+ * pthread mutexes use mutex_t and inherit this behavior.
+ *
+ * The owner is only boosted by the threads waiting directly on the mutex, the
+ * priority is not propagated along a chain of blocked lock owners. When a
+ * thread unlocks a mutex, it continues at the highest priority of its own
+ * and of the threads still waiting on the other mutexes it holds, so mutexes
+ * may be unlocked in any order.
+ *
  * @file
  * @brief       RIOT synchronization API
  *
@@ -23,8 +39,10 @@
 #define MUTEX_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "list.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -40,18 +58,41 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The current owner of the mutex or @ref KERNEL_PID_UNDEF
+     * @note    Only available with module `core_mutex_priority_inheritance`
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Entry in thread_t::held_mutexes of the owner, while threads
+     *          are waiting on the mutex
+     * @note    Only available with module `core_mutex_priority_inheritance`
+     * @internal
+     */
+    list_node_t held;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -72,6 +113,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
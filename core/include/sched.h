@@ -104,6 +104,49 @@ typedef struct _thread thread_t;
 #define SCHED_PRIO_LEVELS 16
 #endif
 
+/**
+ * @def SCHED_PRIO_TWO_LEVEL
+ * @brief Use a two-level bitmap to track runnable priority levels
+ *
+ * By default a single 32 bit word caches which runqueues are non-empty,
+ * limiting @ref SCHED_PRIO_LEVELS to 32. The two-level layout keeps one
+ * 32 bit word per group of 32 priorities plus a summary word marking the
+ * non-empty groups, so finding the next thread still takes exactly two
+ * lookups. It is enabled automatically if @ref SCHED_PRIO_LEVELS exceeds 32.
+ * As thread priorities are stored in a uint8_t, at most 256 levels are
+ * supported.
+ */
+#ifndef SCHED_PRIO_TWO_LEVEL
+#if SCHED_PRIO_LEVELS > 32
+#define SCHED_PRIO_TWO_LEVEL (1)
+#else
+#define SCHED_PRIO_TWO_LEVEL (0)
+#endif
+#endif
+
+#if (SCHED_PRIO_LEVELS > 32) && !SCHED_PRIO_TWO_LEVEL
+#error "SCHED_PRIO_LEVELS > 32 requires SCHED_PRIO_TWO_LEVEL"
+#endif
+
+#if SCHED_PRIO_LEVELS > 256
+#error "SCHED_PRIO_LEVELS must not exceed 256"
+#endif
+
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+/**
+ * @def SCHED_RR_QUANTUM
+ * @brief Time slice in microseconds for threads of the same priority
+ *
+ * With module `sched_round_robin`, a thread that runs for this long while
+ * other threads of its priority are runnable is preempted and moved to the
+ * end of its runqueue. Threads without runnable peers are not interrupted,
+ * so the scheduler stays tickless otherwise.
+ */
+#ifndef SCHED_RR_QUANTUM
+#define SCHED_RR_QUANTUM (10000U)
+#endif
+#endif
+
 /**
  * @brief   Triggers the scheduler to schedule the next thread
  * @returns 1 if sched_active_thread/sched_active_pid was changed, 0 otherwise.
@@ -119,6 +162,32 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief   Make a thread runnable in front of its runqueue
+ *
+ * Used to hand the CPU directly to another thread, e.g. in
+ * msg_send_receive(): unless a thread with a higher priority is runnable,
+ * @p process is the next thread picked by sched_run(), even if other threads
+ * of the same priority are waiting.
+ *
+ * @param[in]   process     Pointer to the thread control block of the
+ *                          targeted process
+ */
+void sched_set_pending_first(thread_t *process);
+
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If @p thread is runnable, it is moved to the runqueue of its new priority.
+ * The caller has to disable interrupts and to call sched_switch() afterwards
+ * if required.
+ *
+ * @param[in]   thread      Pointer to the thread control block of the
+ *                          targeted thread
+ * @param[in]   priority    The new priority of @p thread
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -183,6 +252,11 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+    unsigned int slices;     /**< How often the thread used up its time
+                                  slice and was preempted by a thread of the
+                                  same priority (module `sched_round_robin`) */
+#endif
 } schedstat;
 
 /**
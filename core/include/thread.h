@@ -201,6 +201,14 @@ struct _thread {
     msg_t *msg_array;               /**< memory holding messages sent
                                          to this thread's message queue */
 #endif
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority the thread was created
+                                         with, thread_t::priority may be
+                                         raised above it by mutex priority
+                                         inheritance                    */
+    list_node_t held_mutexes;       /**< mutexes held by the thread that
+                                         other threads are waiting on   */
+#endif
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
     || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
@@ -342,7 +350,7 @@ struct _thread {
 */
 kernel_pid_t thread_create(char *stack,
                   int stacksize,
-                  char priority,
+                  uint8_t priority,
                   int flags,
                   thread_task_func_t task_func,
                   void *arg,
@@ -0,0 +1,117 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_memp
+ * @{
+ *
+ * @file
+ * @brief       Memory pool implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "memp.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static memp_t *_pools;
+
+void memp_init(memp_t *pool, const char *name, void *buf, size_t block_size,
+               unsigned numof)
+{
+    assert(((uintptr_t)buf % sizeof(void *)) == 0);
+    assert(numof <= UINT16_MAX);
+
+    uint8_t *block = buf;
+    block_size = MEMP_BLOCK_SIZE(block_size);
+
+    unsigned state = irq_disable();
+
+    pool->name = name;
+    pool->numof = numof;
+    pool->used = 0;
+    pool->high_water = 0;
+    pool->failures = 0;
+    pool->free = NULL;
+
+    /* link the blocks in address order, so the first allocation returns the
+     * start of buf */
+    for (unsigned i = numof; i > 0; i--) {
+        void **b = (void **)(block + ((i - 1) * block_size));
+        *b = pool->free;
+        pool->free = b;
+    }
+
+    /* a pool may be re-initialized, register it only once */
+    memp_t *p = _pools;
+    while (p && (p != pool)) {
+        p = p->next;
+    }
+    if (p == NULL) {
+        pool->next = _pools;
+        _pools = pool;
+    }
+
+    irq_restore(state);
+
+    DEBUG("memp_init: %s: %u blocks of %u bytes\n", name, numof,
+          (unsigned)block_size);
+}
+
+void *memp_alloc(memp_t *pool)
+{
+    unsigned state = irq_disable();
+    void **block = pool->free;
+
+    if (block == NULL) {
+        pool->failures++;
+        irq_restore(state);
+        DEBUG("memp_alloc: %s: pool exhausted\n", pool->name);
+        return NULL;
+    }
+
+    pool->free = *block;
+    if (++pool->used > pool->high_water) {
+        pool->high_water = pool->used;
+    }
+
+    irq_restore(state);
+    return block;
+}
+
+void memp_free(memp_t *pool, void *block)
+{
+    if (block == NULL) {
+        return;
+    }
+
+    unsigned state = irq_disable();
+
+    assert(pool->used > 0);
+    *((void **)block) = pool->free;
+    pool->free = block;
+    pool->used--;
+
+    irq_restore(state);
+}
+
+void memp_print_stats(void)
+{
+    printf("%-16s | %5s | %5s | %5s | %8s\n",
+           "pool", "size", "used", "max", "failures");
+
+    for (memp_t *pool = _pools; pool; pool = pool->next) {
+        printf("%-16s | %5u | %5u | %5u | %8u\n", pool->name,
+               (unsigned)pool->numof, (unsigned)pool->used,
+               (unsigned)pool->high_water, (unsigned)pool->failures);
+    }
+}
@@ -32,6 +32,7 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#include "sched_trace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -97,6 +98,8 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         return -1;
     }
 
+    SCHED_TRACE(SCHED_TRACE_MSG_SEND, target_pid, m->type);
+
     thread_t *me = (thread_t *) sched_active_thread;
 
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
@@ -197,6 +200,8 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
         return -1;
     }
 
+    SCHED_TRACE(SCHED_TRACE_MSG_SEND, target_pid, m->type);
+
     m->sender_pid = KERNEL_PID_ISR;
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
@@ -217,11 +222,85 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 }
 
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned n = 0;
+    int woken = 0;
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_bulk: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", sender_pid, target_pid);
+        /* copy first msg to target */
+        m[0].sender_pid = sender_pid;
+        msg_t *target_message = (msg_t*) target->wait_data;
+        *target_message = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        SCHED_TRACE(SCHED_TRACE_MSG_SEND, target_pid, m[0].type);
+        woken = 1;
+        n++;
+    }
+
+    for (; n < num; n++) {
+        m[n].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[n])) {
+            break;
+        }
+        SCHED_TRACE(SCHED_TRACE_MSG_SEND, target_pid, m[n].type);
+    }
+
+    DEBUG("msg_send_bulk: delivered %u of %u messages to %" PRIkernel_pid
+          ".\n", n, num, target_pid);
+
+    uint16_t target_prio = target->priority;
+    irq_restore(state);
+    if (woken) {
+        sched_switch(target_prio);
+    }
+
+    return n;
+}
+
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
 {
     assert(sched_active_pid != target_pid);
     unsigned state = irq_disable();
     thread_t *me = (thread_t*) sched_threads[sched_active_pid];
+    thread_t *target = (thread_t*) sched_threads[target_pid];
+
+    if (target && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_send_receive: %" PRIkernel_pid ": Direct handoff to %"
+              PRIkernel_pid ".\n", me->pid, target_pid);
+        /* copy msg to target, the target runs next instead of us */
+        msg_t *target_message = (msg_t*) target->wait_data;
+        *target_message = *m;
+        target_message->sender_pid = me->pid;
+        SCHED_TRACE(SCHED_TRACE_MSG_SEND, target_pid, m->type);
+
+        me->wait_data = (void*) reply;
+        sched_set_status(me, STATUS_REPLY_BLOCKED);
+        sched_set_pending_first(target);
+
+        irq_restore(state);
+        thread_yield_higher();
+        return 1;
+    }
+
     sched_set_status(me, STATUS_REPLY_BLOCKED);
     me->wait_data = (void*) reply;
 
@@ -251,10 +330,15 @@ int msg_reply(msg_t *m, msg_t *reply)
     /* copy msg to target */
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
-    sched_set_status(target, STATUS_PENDING);
+    SCHED_TRACE(SCHED_TRACE_MSG_SEND, target->pid, reply->type);
+    sched_set_pending_first(target);
     uint16_t target_prio = target->priority;
     irq_restore(state);
-    sched_switch(target_prio);
+
+    /* switch back directly, unless the sender has a lower priority */
+    if (target_prio <= sched_active_thread->priority) {
+        thread_yield_higher();
+    }
 
     return 1;
 }
@@ -271,6 +355,7 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
+    SCHED_TRACE(SCHED_TRACE_MSG_SEND, target->pid, reply->type);
     sched_set_status(target, STATUS_PENDING);
     sched_context_switch_request = 1;
     return 1;
@@ -286,6 +371,83 @@ int msg_receive(msg_t *m)
     return _msg_receive(m, 1);
 }
 
+int msg_receive_bulk(msg_t *m, unsigned num)
+{
+    assert(num > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_active_thread;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    if (me->msg_array) {
+        int queue_index;
+        while ((n < num) &&
+               ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+            m[n] = me->msg_array[queue_index];
+            SCHED_TRACE(SCHED_TRACE_MSG_RECEIVE, me->pid, m[n].type);
+            n++;
+        }
+    }
+
+    /* take over the messages of threads waiting to send */
+    while (n < num) {
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        if (next == NULL) {
+            break;
+        }
+
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        m[n] = *((msg_t*) sender->wait_data);
+        SCHED_TRACE(SCHED_TRACE_MSG_RECEIVE, me->pid, m[n].type);
+        n++;
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    /* like msg_receive(), take the messages of waiting threads into the just
+     * freed queue space */
+    while (me->msg_array && me->msg_waiters.next) {
+        int queue_index = cib_put(&(me->msg_queue));
+        if (queue_index < 0) {
+            break;
+        }
+
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        me->msg_array[queue_index] = *((msg_t*) sender->wait_data);
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < sender_prio) {
+                sender_prio = sender->priority;
+            }
+        }
+    }
+
+    irq_restore(state);
+
+    if (n == 0) {
+        /* nothing pending, block until the first message arrives */
+        return _msg_receive(m, 1);
+    }
+
+    DEBUG("msg_receive_bulk: %" PRIkernel_pid ": got %u messages.\n",
+          me->pid, n);
+
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
 static int _msg_receive(msg_t *m, int block)
 {
     unsigned state = irq_disable();
@@ -310,6 +472,7 @@ static int _msg_receive(msg_t *m, int block)
         DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive(): We've got a queued message.\n",
               sched_active_thread->pid);
         *m = me->msg_array[queue_index];
+        SCHED_TRACE(SCHED_TRACE_MSG_RECEIVE, me->pid, m->type);
     }
     else {
         me->wait_data = (void *) m;
@@ -330,6 +493,7 @@ static int _msg_receive(msg_t *m, int block)
             thread_yield_higher();
 
             /* sender copied message */
+            SCHED_TRACE(SCHED_TRACE_MSG_RECEIVE, me->pid, m->type);
         }
         else {
             irq_restore(state);
@@ -353,6 +517,9 @@ static int _msg_receive(msg_t *m, int block)
         /* copy msg */
         msg_t *sender_msg = (msg_t*) sender->wait_data;
         *m = *sender_msg;
+        if (queue_index < 0) {
+            SCHED_TRACE(SCHED_TRACE_MSG_RECEIVE, me->pid, m->type);
+        }
 
         /* remove sender from queue */
         uint16_t sender_prio = THREAD_PRIORITY_IDLE;
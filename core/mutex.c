@@ -28,10 +28,106 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#include "sched_trace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static inline thread_t *_owner(mutex_t *mutex)
+{
+    if (mutex->owner == KERNEL_PID_UNDEF) {
+        return NULL;
+    }
+    return (thread_t *)sched_threads[mutex->owner];
+}
+
+static inline int _has_waiters(mutex_t *mutex)
+{
+    return (mutex->queue.next != NULL) && (mutex->queue.next != MUTEX_LOCKED);
+}
+
+/* the owner runs at the priority of the first (i.e. highest priority) waiter
+ * of every mutex it holds, if that is higher than its own */
+static uint8_t _inherited_priority(thread_t *owner)
+{
+    uint8_t priority = owner->base_priority;
+
+    for (list_node_t *node = owner->held_mutexes.next; node;
+         node = node->next) {
+        mutex_t *mutex = container_of(node, mutex_t, held);
+
+        if (_has_waiters(mutex)) {
+            thread_t *waiter = container_of((clist_node_t *)mutex->queue.next,
+                                            thread_t, rq_entry);
+
+            if (waiter->priority < priority) {
+                priority = waiter->priority;
+            }
+        }
+    }
+    return priority;
+}
+
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    mutex->owner = owner->pid;
+    /* remaining waiters of a handed over mutex have no higher priority than
+     * the new owner, but have to be accounted for when it unlocks another
+     * mutex */
+    if (_has_waiters(mutex)) {
+        list_add(&owner->held_mutexes, &mutex->held);
+    }
+}
+
+static inline void _boost_owner(mutex_t *mutex, thread_t *waiter)
+{
+    thread_t *owner = _owner(mutex);
+
+    if (owner == NULL) {
+        return;
+    }
+    /* only mutexes with waiters are tracked, so a mutex that is abandoned
+     * while locked (e.g. one on the stack) is never referenced by its owner */
+    list_remove(&owner->held_mutexes, &mutex->held);
+    list_add(&owner->held_mutexes, &mutex->held);
+    if (owner->priority > waiter->priority) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu32 "\n", waiter->pid, owner->pid,
+              (uint32_t)waiter->priority);
+        sched_change_priority(owner, waiter->priority);
+    }
+}
+
+static inline void _restore_owner(mutex_t *mutex)
+{
+    thread_t *owner = _owner(mutex);
+
+    if (owner != NULL) {
+        list_remove(&owner->held_mutexes, &mutex->held);
+        sched_change_priority(owner, _inherited_priority(owner));
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    (void)mutex;
+    (void)owner;
+}
+
+static inline void _boost_owner(mutex_t *mutex, thread_t *waiter)
+{
+    (void)mutex;
+    (void)waiter;
+}
+
+static inline void _restore_owner(mutex_t *mutex)
+{
+    (void)mutex;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +137,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t*)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -51,6 +148,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
+        SCHED_TRACE(SCHED_TRACE_MUTEX_BLOCK, me->pid, (uintptr_t)mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t*)&me->rq_entry;
             mutex->queue.next->next = NULL;
@@ -58,6 +156,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+        _boost_owner(mutex, me);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -85,11 +184,14 @@ void mutex_unlock(mutex_t *mutex)
 
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
+        _restore_owner(mutex);
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
         return;
     }
 
+    _restore_owner(mutex);
+
     list_node_t *next = list_remove_head(&mutex->queue);
 
     thread_t *process = container_of((clist_node_t*)next, thread_t, rq_entry);
@@ -97,6 +199,8 @@ void mutex_unlock(mutex_t *mutex)
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+    SCHED_TRACE(SCHED_TRACE_MUTEX_UNBLOCK, process->pid, (uintptr_t)mutex);
+    _set_owner(mutex, process);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -114,6 +218,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        _restore_owner(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -123,6 +228,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+            SCHED_TRACE(SCHED_TRACE_MUTEX_UNBLOCK, process->pid,
+                        (uintptr_t)mutex);
+            _set_owner(mutex, process);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
@@ -28,12 +28,13 @@
 #include "thread.h"
 #include "irq.h"
 #include "log.h"
+#include "sched_trace.h"
 
 #ifdef MODULE_MPU_STACK_GUARD
 #include "mpu.h"
 #endif
 
-#ifdef MODULE_SCHEDSTATISTICS
+#if defined(MODULE_SCHEDSTATISTICS) || defined(MODULE_SCHED_ROUND_ROBIN)
 #include "xtimer.h"
 #endif
 
@@ -55,8 +56,51 @@ volatile thread_t *sched_active_thread;
 volatile kernel_pid_t sched_active_pid = KERNEL_PID_UNDEF;
 
 clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
+
+#if SCHED_PRIO_TWO_LEVEL
+#define SCHED_PRIO_GROUPS ((SCHED_PRIO_LEVELS + 31) / 32)
+
+static uint32_t runqueue_groupcache = 0;
+static uint32_t runqueue_bitcache[SCHED_PRIO_GROUPS];
+
+static inline void _runqueue_mark(uint16_t prio)
+{
+    runqueue_bitcache[prio >> 5] |= (uint32_t)1 << (prio & 0x1f);
+    runqueue_groupcache |= (uint32_t)1 << (prio >> 5);
+}
+
+static inline void _runqueue_unmark(uint16_t prio)
+{
+    runqueue_bitcache[prio >> 5] &= ~((uint32_t)1 << (prio & 0x1f));
+    if (!runqueue_bitcache[prio >> 5]) {
+        runqueue_groupcache &= ~((uint32_t)1 << (prio >> 5));
+    }
+}
+
+static inline int _runqueue_first(void)
+{
+    int group = bitarithm_lsb(runqueue_groupcache);
+    return (group << 5) + bitarithm_lsb(runqueue_bitcache[group]);
+}
+#else
 static uint32_t runqueue_bitcache = 0;
 
+static inline void _runqueue_mark(uint16_t prio)
+{
+    runqueue_bitcache |= (uint32_t)1 << prio;
+}
+
+static inline void _runqueue_unmark(uint16_t prio)
+{
+    runqueue_bitcache &= ~((uint32_t)1 << prio);
+}
+
+static inline int _runqueue_first(void)
+{
+    return bitarithm_lsb(runqueue_bitcache);
+}
+#endif
+
 /* Needed by OpenOCD to read sched_threads */
 #if defined(__APPLE__) && defined(__MACH__)
  #define FORCE_USED_SECTION __attribute__((used)) __attribute__((section ("__OPENOCD,__openocd")))
@@ -79,6 +123,56 @@ static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 #endif
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+static void _rr_expired(void *arg);
+
+static xtimer_t _rr_timer = { .callback = _rr_expired };
+
+/* thread the time slice timer is currently running for */
+static thread_t *_rr_thread;
+
+static inline int _rr_has_peers(thread_t *thread)
+{
+    return (thread->status >= STATUS_ON_RUNQUEUE) &&
+           (thread->rq_entry.next != &thread->rq_entry);
+}
+
+static void _rr_expired(void *arg)
+{
+    (void)arg;
+    thread_t *active_thread = (thread_t *)sched_active_thread;
+
+    if ((active_thread == _rr_thread) && _rr_has_peers(active_thread)) {
+        DEBUG("sched_rr: time slice of %" PRIkernel_pid " expired.\n",
+              active_thread->pid);
+        /* the active thread is first in its runqueue, move it to the end */
+        clist_lpoprpush(&sched_runqueues[active_thread->priority]);
+#ifdef MODULE_SCHEDSTATISTICS
+        sched_pidlist[active_thread->pid].slices++;
+#endif
+        sched_context_switch_request = 1;
+    }
+    _rr_thread = NULL;
+}
+
+/**
+ * @brief   Start a time slice for the active thread if it has runnable peers
+ */
+static void _rr_update(thread_t *active_thread)
+{
+    if (active_thread && _rr_has_peers(active_thread)) {
+        if (_rr_thread != active_thread) {
+            _rr_thread = active_thread;
+            xtimer_set(&_rr_timer, SCHED_RR_QUANTUM);
+        }
+    }
+    else if (_rr_thread) {
+        xtimer_remove(&_rr_timer);
+        _rr_thread = NULL;
+    }
+}
+#endif
+
 int __attribute__((used)) sched_run(void)
 {
     sched_context_switch_request = 0;
@@ -88,7 +182,7 @@ int __attribute__((used)) sched_run(void)
     /* The bitmask in runqueue_bitcache is never empty,
      * since the threading should not be started before at least the idle thread was started.
      */
-    int nextrq = bitarithm_lsb(runqueue_bitcache);
+    int nextrq = _runqueue_first();
     thread_t *next_thread = container_of(sched_runqueues[nextrq].next->next, thread_t, rq_entry);
 
     DEBUG("sched_run: active thread: %" PRIkernel_pid ", next thread: %" PRIkernel_pid "\n",
@@ -136,6 +230,13 @@ int __attribute__((used)) sched_run(void)
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
 
+    SCHED_TRACE(SCHED_TRACE_SWITCH, next_thread->pid,
+                (active_thread == NULL) ? KERNEL_PID_UNDEF : active_thread->pid);
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    _rr_update(next_thread);
+#endif
+
 #ifdef MODULE_MPU_STACK_GUARD
     mpu_configure(
         1,                                                /* MPU region 1 */
@@ -165,7 +266,14 @@ void sched_set_status(thread_t *process, unsigned int status)
             DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu16 ".\n",
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
-            runqueue_bitcache |= 1 << process->priority;
+            _runqueue_mark(process->priority);
+#ifdef MODULE_SCHED_ROUND_ROBIN
+            /* a peer of the active thread became runnable */
+            if (sched_active_thread &&
+                (process->priority == sched_active_thread->priority)) {
+                _rr_update((thread_t *)sched_active_thread);
+            }
+#endif
         }
     }
     else {
@@ -175,7 +283,7 @@ void sched_set_status(thread_t *process, unsigned int status)
             clist_lpop(&sched_runqueues[process->priority]);
 
             if (!sched_runqueues[process->priority].next) {
-                runqueue_bitcache &= ~(1 << process->priority);
+                _runqueue_unmark(process->priority);
             }
         }
     }
@@ -183,6 +291,53 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
+void sched_set_pending_first(thread_t *process)
+{
+    if (process->status < STATUS_ON_RUNQUEUE) {
+        DEBUG("sched_set_pending_first: adding thread %" PRIkernel_pid
+              " to front of runqueue %" PRIu16 ".\n",
+              process->pid, process->priority);
+        clist_lpush(&sched_runqueues[process->priority], &(process->rq_entry));
+        _runqueue_mark(process->priority);
+#ifdef MODULE_SCHED_ROUND_ROBIN
+        if (sched_active_thread &&
+            (process->priority == sched_active_thread->priority)) {
+            _rr_update((thread_t *)sched_active_thread);
+        }
+#endif
+    }
+
+    process->status = STATUS_PENDING;
+}
+
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid ": %" PRIu16
+          " -> %" PRIu16 "\n", thread->pid, (uint16_t)thread->priority,
+          (uint16_t)priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &(thread->rq_entry));
+        if (!sched_runqueues[thread->priority].next) {
+            _runqueue_unmark(thread->priority);
+        }
+        /* the active thread has to stay in front of its runqueue */
+        if (thread == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &(thread->rq_entry));
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &(thread->rq_entry));
+        }
+        _runqueue_mark(priority);
+    }
+
+    thread->priority = priority;
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
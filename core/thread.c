@@ -140,11 +140,13 @@ uintptr_t thread_measure_stack_free(char *stack)
 }
 #endif
 
-kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags, thread_task_func_t function, void *arg, const char *name)
+kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority, int flags, thread_task_func_t function, void *arg, const char *name)
 {
+#if SCHED_PRIO_LEVELS < 256
     if (priority >= SCHED_PRIO_LEVELS) {
         return -EINVAL;
     }
+#endif
 
 #ifdef DEVELHELP
     int total_stacksize = stacksize;
@@ -223,6 +225,11 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->priority = priority;
     cb->status = 0;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    cb->base_priority = priority;
+    cb->held_mutexes.next = NULL;
+#endif
+
     cb->rq_entry.next = NULL;
 
 #ifdef MODULE_CORE_MSG
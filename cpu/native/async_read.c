@@ -22,11 +22,17 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
 
 static int _next_index;
+#ifdef __linux__
+static int _epoll_fd = -1;
+#endif
 static int _fds[ASYNC_READ_NUMOF];
 static void *_args[ASYNC_READ_NUMOF];
 static native_async_read_callback_t _native_async_read_callbacks[ASYNC_READ_NUMOF];
@@ -36,6 +42,19 @@ static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef __linux__
+/* the interest set lives in the kernel, so only ready fds are visited */
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+
+    int n = epoll_wait(_epoll_fd, events, ASYNC_READ_NUMOF, 0);
+
+    for (int i = 0; i < n; i++) {
+        int index = events[i].data.u32;
+        _native_async_read_callbacks[index](_fds[index], _args[index]);
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,8 +80,17 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if (_epoll_fd == -1) {
+        _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd == -1) {
+            err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+        }
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
@@ -75,6 +103,13 @@ void native_async_read_cleanup(void) {
 #endif
         real_close(_fds[i]);
     }
+
+#ifdef __linux__
+    if (_epoll_fd != -1) {
+        real_close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+#endif
 }
 
 void native_async_read_continue(int fd) {
@@ -102,6 +137,15 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
      * * check http://sourceforge.net/p/tuntaposx/bugs/17/ */
     _sigio_child(_next_index);
 #else
+#ifdef __linux__
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data.u32 = _next_index,
+    };
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#endif
     /* configure fds to send signals on io */
     if (real_fcntl(fd, F_SETOWN, _native_pid) == -1) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETOWN)");
@@ -24,9 +24,13 @@ extern "C" {
 
 /**
  * @brief   Maximum number of file descriptors
+ *
+ * On Linux, the descriptors are watched with an epoll instance, so a SIGIO
+ * only costs time for the descriptors that are actually readable.  On other
+ * hosts, all descriptors are polled with select() on every SIGIO.
  */
 #ifndef ASYNC_READ_NUMOF
-#define ASYNC_READ_NUMOF 2
+#define ASYNC_READ_NUMOF 16
 #endif
 
 /**
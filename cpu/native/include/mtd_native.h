@@ -12,6 +12,18 @@
  * @{
  * @brief       mtd flash emulation for native
  *
+ * The flash is emulated by a file on the host, which behaves like NOR flash:
+ * programming only clears bits, erasing sets whole sectors to 0xff.
+ *
+ * By default, the file is opened and accessed with stdio on every operation.
+ * With the module `mtd_native_mmap`, the file is mapped into memory once on
+ * initialization and all operations work on the mapping, so the cost of an
+ * operation is close to that of the emulated memory accesses.
+ *
+ * The driver counts the read, program and erase operations per sector and
+ * the bytes moved by them, so that filesystem benchmarks can report wear and
+ * I/O amplification (see @ref mtd_native_stats_print).
+ *
  * @file
  *
  * @author      Vincent Dupont <vincent@otakeys.com>
@@ -24,12 +36,37 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 #include "mtd.h"
 
+/**
+ * @brief   Operations on a single sector
+ */
+typedef struct {
+    uint32_t reads;                 /**< read operations touching the sector */
+    uint32_t programs;              /**< program operations in the sector */
+    uint32_t erases;                /**< erase cycles of the sector */
+} mtd_native_sector_stats_t;
+
+/**
+ * @brief   Access statistics of a native mtd device
+ */
+typedef struct {
+    uint64_t read_bytes;            /**< bytes read */
+    uint64_t program_bytes;         /**< bytes programmed */
+    uint64_t erase_bytes;           /**< bytes erased */
+    mtd_native_sector_stats_t *sectors; /**< per sector, allocated on init */
+} mtd_native_stats_t;
+
 /** mtd native descriptor */
 typedef struct mtd_native_dev {
     mtd_dev_t dev;      /**< mtd generic device */
     const char *fname;  /**< filename to use for memory emulation */
+#if defined(MODULE_MTD_NATIVE_MMAP) || defined(DOXYGEN)
+    uint8_t *map;       /**< file mapped into memory, NULL before init */
+#endif
+    mtd_native_stats_t stats;   /**< access statistics */
 } mtd_native_dev_t;
 
 /**
@@ -37,6 +74,23 @@ typedef struct mtd_native_dev {
  */
 extern const mtd_desc_t native_flash_driver;
 
+/**
+ * @brief   Reset the access statistics of a device
+ *
+ * @param[in] dev   initialized device
+ */
+void mtd_native_stats_reset(mtd_native_dev_t *dev);
+
+/**
+ * @brief   Print the access statistics of a device to stdout
+ *
+ * Prints the totals, the highest erase count of any sector and the counters
+ * of every sector accessed since the last reset.
+ *
+ * @param[in] dev   initialized device
+ */
+void mtd_native_stats_print(const mtd_native_dev_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
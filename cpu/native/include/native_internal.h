@@ -20,6 +20,7 @@
 #define NATIVE_INTERNAL_H
 
 #include <signal.h>
+#include <stdbool.h>
 #include <stdio.h>
 /* enable signal handler register access on different platforms
  * check here for more:
@@ -131,6 +132,7 @@ extern int (*real_fputc)(int c, FILE *stream);
 extern int (*real_fgetc)(FILE *stream);
 extern mode_t (*real_umask)(mode_t cmask);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+extern ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
 #else
@@ -165,6 +167,28 @@ ssize_t _native_read(int fd, void *buf, size_t count);
 ssize_t _native_write(int fd, const void *buf, size_t count);
 ssize_t _native_writev(int fildes, const struct iovec *iov, int iovcnt);
 
+#ifdef MODULE_NATIVE_VTIME
+/**
+ * Advance the virtual clock to the next timer deadline and raise the timer
+ * interrupt, call with interrupts disabled.
+ * Returns false if no timer channel is set.
+ */
+bool native_vtime_advance(void);
+#endif
+
+#ifdef MODULE_NATIVE_PROF
+/**
+ * Start sampling, the profile is written to path (or the default file if
+ * NULL) on exit.
+ */
+void native_prof_init(const char *path);
+
+/**
+ * SIGPROF handler, records the interrupted stack
+ */
+void native_prof_sample(int sig, siginfo_t *info, void *context);
+#endif
+
 /**
  * @endcond
  */
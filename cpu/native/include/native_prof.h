@@ -0,0 +1,89 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Thread-aware sampling profiler for native
+ *
+ * With the `native_prof` module, the process is interrupted by `SIGPROF`
+ * every 1 / @ref NATIVE_PROF_HZ seconds of consumed CPU time.  Each sample
+ * records the interrupted call stack together with the RIOT thread that was
+ * running (or `isr` while an interrupt handler was executing), so host tools
+ * that only see one Linux thread can be avoided.
+ *
+ * Samples are aggregated in a fixed-size table and written as folded stacks
+ * when the instance exits, one line per distinct stack:
+ *
+ *     <thread>;<outermost function>;...;<sampled function> <count>
+ *
+ * The file name defaults to `<elf file>.<pid>.folded` and can be set with the
+ * `-P <file>` command line option.  The output is understood by
+ * `flamegraph.pl` and `speedscope` directly.
+ *
+ * Call stacks are walked along frame pointers, so the module builds all code
+ * with `-fno-omit-frame-pointer`.  On other platforms than Linux/x86 only the
+ * sampled function is recorded.
+ *
+ * @note    `SIGPROF` interrupts blocking system calls such as `pause()` and
+ *          `select()`, which native already treats like any other signal.
+ */
+
+#ifndef NATIVE_PROF_H
+#define NATIVE_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Sampling rate in Hz of consumed CPU time
+ */
+#ifndef NATIVE_PROF_HZ
+#define NATIVE_PROF_HZ          (997U)
+#endif
+
+/**
+ * @brief   Maximum number of frames recorded per sample
+ */
+#ifndef NATIVE_PROF_DEPTH
+#define NATIVE_PROF_DEPTH       (32U)
+#endif
+
+/**
+ * @brief   Number of distinct stacks that can be recorded
+ *
+ * Samples of further stacks are dropped and counted in the output.
+ */
+#ifndef NATIVE_PROF_SLOTS
+#define NATIVE_PROF_SLOTS       (2048U)
+#endif
+
+/**
+ * @brief   Write the folded stacks sampled so far
+ *
+ * Sampling is paused while the stacks are written.
+ *
+ * @param[in] path  file to write to, stdout if NULL
+ *
+ * @return  0 on success
+ * @return  -errno if @p path can not be written
+ */
+int native_prof_dump(const char *path);
+
+/**
+ * @brief   Discard all samples taken so far
+ */
+void native_prof_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_PROF_H */
+/** @} */
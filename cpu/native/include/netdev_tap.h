@@ -9,6 +9,20 @@
 /**
  * @ingroup     netdev
  * @brief       Low-level ethernet driver for native tap interfaces
+ *
+ * With the module `netdev_tap_vnet_hdr`, the TAP is opened with
+ * `IFF_VNET_HDR` (Linux only) and every frame is exchanged with the host
+ * together with a `struct virtio_net_hdr`.  The driver then supports
+ * @ref NETOPT_RX_CHECKSUM_OFFLOAD and @ref NETOPT_TX_CHECKSUM_OFFLOAD for UDP,
+ * TCP and ICMPv6 messages directly following the IPv6 header of a frame:
+ *
+ * - On reception, frames the host marks as verified are passed up as they
+ *   are.  Frames the host sent with a partial checksum get their checksum
+ *   completed by the driver, so they can be forwarded to interfaces without
+ *   offload.  All others are verified by the driver, which drops those with
+ *   an invalid checksum.
+ * - On transmission, frames whose checksum field holds just the sum over the
+ *   IPv6 pseudo-header are handed to the host to complete the checksum.
  * @{
  *
  * @file
@@ -27,6 +41,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +50,30 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Number of frames buffered by the RX ring of a TAP in batched mode
+ *
+ * With the module `netdev_tap_batch`, all pending frames (up to this number)
+ * are read from the TAP when it signals input, and handed to the upper layer
+ * in one go.  Without the module, a single frame is read per signal.
+ */
+#ifndef NETDEV_TAP_RX_RING
+#define NETDEV_TAP_RX_RING          (8U)
+#endif
+
+/**
+ * @brief   Number of queues opened per TAP in multi-queue mode
+ *
+ * With the module `netdev_tap_mq`, the TAP is opened with `IFF_MULTI_QUEUE`
+ * and this many queues are attached to it (Linux only).  The host spreads
+ * the frames it sends over the queues, and all queues are drained into the
+ * RX ring.  The TAP must be created as multi-queue interface, e.g. with
+ * `ip tuntap add dev tap0 mode tap multi_queue`.
+ */
+#ifndef NETDEV_TAP_QUEUES
+#define NETDEV_TAP_QUEUES           (2U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -42,8 +81,22 @@ typedef struct netdev_tap {
     netdev_t netdev;                    /**< netdev internal member */
     char tap_name[IFNAMSIZ];            /**< host dev file name */
     int tap_fd;                         /**< host file descriptor for the TAP */
+#ifdef MODULE_NETDEV_TAP_MQ
+    int queue_fds[NETDEV_TAP_QUEUES];   /**< file descriptors of all queues,
+                                             the first one is tap_fd */
+#endif
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+    uint8_t rx_csum_offload;            /**< Flag for RX checksum offload */
+    uint8_t tx_csum_offload;            /**< Flag for TX checksum offload */
+#endif
+#ifdef MODULE_NETDEV_TAP_BATCH
+    uint8_t rx_head;                    /**< next frame in the RX ring */
+    uint8_t rx_numof;                   /**< number of frames in the RX ring */
+    uint16_t rx_len[NETDEV_TAP_RX_RING];    /**< lengths of the buffered frames */
+    uint8_t rx_ring[NETDEV_TAP_RX_RING][ETHERNET_FRAME_LEN]; /**< RX ring */
+#endif
 } netdev_tap_t;
 
 /**
@@ -0,0 +1,106 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     netdev
+ * @brief       IEEE 802.15.4 driver for native on a shared memory medium
+ *
+ * The driver attaches a native instance as one node to a virtual radio
+ * medium (see @ref vradio_medium.h) served by the `vradiod` daemon in
+ * `dist/tools/vradio`.  The daemon decides which nodes hear each other, and
+ * with which loss and latency, so any number of native instances on one host
+ * can form a multi-hop 802.15.4 network running the full GNRC 6LoWPAN and MAC
+ * layer stack.
+ *
+ * The node number is given with the `-r <node>[:<medium>]` command line
+ * option.  The long and short address of the device are derived from it, so
+ * the addresses are reproducible between runs.
+ *
+ * The radio behaves like a transceiver with hardware address filtering:
+ *
+ * - Frames are only delivered while the radio is idle or receiving
+ *   (@ref NETOPT_STATE), and only on the channel it is tuned to.
+ * - Frames neither addressed to the device nor broadcast are dropped unless
+ *   @ref NETOPT_PROMISCUOUSMODE is enabled.
+ * - @ref NETOPT_PRELOADING is supported, CSMA and acknowledgements are not
+ *   simulated: every transmission succeeds once handed to the medium.
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the native virtual radio driver
+ */
+#ifndef NETDEV_VRADIO_H
+#define NETDEV_VRADIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+#include "net/netopt.h"
+#include "vradio_medium.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of virtual radios of an instance
+ */
+#ifndef NETDEV_VRADIO_MAX
+#define NETDEV_VRADIO_MAX           (1)
+#endif
+
+/**
+ * @brief   Virtual radio configuration parameters
+ */
+typedef struct {
+    const char *medium;                 /**< name of the medium */
+    unsigned node;                      /**< node number on the medium */
+} netdev_vradio_params_t;
+
+/**
+ * @brief   Virtual radio device state
+ */
+typedef struct {
+    netdev_ieee802154_t netdev;         /**< IEEE 802.15.4 netdev base */
+    netdev_vradio_params_t params;      /**< configuration parameters */
+    vradio_medium_t *medium;            /**< attached medium */
+    vradio_node_t *node;                /**< this node on the medium */
+    int sock;                           /**< socket to and from the daemon */
+    netopt_state_t state;               /**< current radio state */
+    bool preloading;                    /**< send() only loads the frame */
+    bool promiscuous;                   /**< address filter disabled */
+    bool tell_rx_start;                 /**< signal NETDEV_EVENT_RX_STARTED */
+    bool tell_tx_start;                 /**< signal NETDEV_EVENT_TX_STARTED */
+    vradio_frame_t tx_frame;            /**< loaded frame */
+} netdev_vradio_t;
+
+/**
+ * @brief   Configuration parameters for @ref netdev_vradio_t
+ *
+ * @note    This variable is set on native start-up based on arguments provided
+ */
+extern netdev_vradio_params_t netdev_vradio_params[NETDEV_VRADIO_MAX];
+
+/**
+ * @brief   Setup a virtual radio device
+ *
+ * The device attaches to its medium when it is initialized.  The instance
+ * exits if the medium can not be attached to.
+ *
+ * @param[out] dev      device to set up
+ * @param[in] params    configuration parameters
+ */
+void netdev_vradio_setup(netdev_vradio_t *dev,
+                         const netdev_vradio_params_t *params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETDEV_VRADIO_H */
+/** @} */
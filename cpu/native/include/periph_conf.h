@@ -48,6 +48,18 @@
 #define TIMER_NUMOF        (1U)
 #define TIMER_0_EN         1
 
+/**
+ * @brief   Number of channels of timer 0
+ *
+ * With the module `native_hrtimer`, every channel is backed by its own host
+ * timer.  Otherwise there is a single channel.
+ */
+#ifdef MODULE_NATIVE_HRTIMER
+#define TIMER_0_CHANNELS   (4U)
+#else
+#define TIMER_0_CHANNELS   (1U)
+#endif
+
 /**
  * @brief xtimer configuration
  * @{
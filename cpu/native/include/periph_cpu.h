@@ -19,6 +19,9 @@
 #ifndef PERIPH_CPU_H
 #define PERIPH_CPU_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "periph/dev_enums.h"
 
 #ifdef __cplusplus
@@ -37,6 +40,29 @@ extern "C" {
  */
 #define PERIPH_TIMER_PROVIDES_SET
 
+#if defined(MODULE_NATIVE_HRTIMER) || defined(DOXYGEN)
+/**
+ * @brief   Wake-up jitter of the timer with `native_hrtimer`
+ *
+ * The jitter of a timer interrupt is the time between the deadline of the
+ * channel and the start of the interrupt handler.
+ */
+typedef struct {
+    uint32_t count;             /**< number of timer interrupts */
+    uint32_t max;               /**< maximum jitter in ns */
+    uint64_t sum;               /**< sum of the jitter of all interrupts in ns */
+} native_timer_jitter_t;
+
+/**
+ * @brief   Get the wake-up jitter of the timer since initialization or the
+ *          last reset
+ *
+ * @param[out] jitter   the jitter statistics
+ * @param[in] reset     reset the statistics after reading them
+ */
+void native_timer_jitter(native_timer_jitter_t *jitter, bool reset);
+#endif
+
 /**
  * @name    Power management configuration
  * @{
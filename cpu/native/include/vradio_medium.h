@@ -0,0 +1,170 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     netdev
+ * @{
+ *
+ * @file
+ * @brief       Shared memory layout of the native virtual radio medium
+ *
+ * The medium is a POSIX shared memory object created by the `vradiod` daemon
+ * in `dist/tools/vradio`.  It holds a TX and an RX ring per node.  A node
+ * (@ref netdev_vradio.h) puts the frames it sends into its TX ring and kicks
+ * the daemon through the daemon's UNIX datagram socket.  The daemon moves
+ * the frames into the RX rings of the node's neighbours according to its
+ * topology and kicks each of them through their own socket.
+ *
+ * Every ring has a single producer and a single consumer, so head and tail
+ * are only ever written by one side each.
+ *
+ * This header is shared with the daemon and must not depend on RIOT.
+ */
+#ifndef VRADIO_MEDIUM_H
+#define VRADIO_MEDIUM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number at the start of the shared memory object
+ */
+#define VRADIO_MEDIUM_MAGIC         (0x52564d31UL)
+
+/**
+ * @brief   Default name of the medium
+ */
+#define VRADIO_MEDIUM_DEFAULT       "riot_vradio"
+
+/**
+ * @brief   Maximum number of nodes attached to one medium
+ */
+#define VRADIO_MEDIUM_NODES_MAX     (64U)
+
+/**
+ * @brief   Number of frames in a ring, must be a power of two
+ */
+#define VRADIO_RING_SIZE            (16U)
+
+/**
+ * @brief   Maximum length of a frame (PSDU without FCS)
+ */
+#define VRADIO_FRAME_MAX            (125U)
+
+/**
+ * @name    Host paths belonging to a medium
+ *
+ * The shared memory object and the UNIX datagram sockets of the daemon and
+ * the nodes are derived from the name of the medium.
+ * @{
+ */
+#define VRADIO_SHM_FMT              "/%s"
+#define VRADIO_DAEMON_SOCK_FMT      "/tmp/%s.sock"
+#define VRADIO_NODE_SOCK_FMT        "/tmp/%s.%u.sock"
+/** @} */
+
+/**
+ * @brief   A frame in transit
+ */
+typedef struct {
+    uint8_t len;                        /**< length of the frame */
+    uint8_t channel;                    /**< channel the frame is sent on */
+    int8_t rssi;                        /**< RSSI at the receiver in dBm */
+    uint8_t lqi;                        /**< LQI at the receiver */
+    uint8_t data[VRADIO_FRAME_MAX];     /**< frame, starting with the MHR */
+} vradio_frame_t;
+
+/**
+ * @brief   Single producer, single consumer frame ring
+ */
+typedef struct {
+    uint32_t head;                      /**< written by the producer only */
+    uint32_t tail;                      /**< written by the consumer only */
+    vradio_frame_t frames[VRADIO_RING_SIZE];    /**< frame slots */
+} vradio_ring_t;
+
+/**
+ * @brief   Per node state on the medium
+ */
+typedef struct {
+    uint32_t pid;                       /**< process attached, 0 if none */
+    uint8_t channel;                    /**< channel the node listens on */
+    uint8_t rx_on;                      /**< node receives, if not 0 */
+    vradio_ring_t tx;                   /**< frames from the node */
+    vradio_ring_t rx;                   /**< frames to the node */
+} vradio_node_t;
+
+/**
+ * @brief   The shared memory object
+ */
+typedef struct {
+    uint32_t magic;                     /**< @ref VRADIO_MEDIUM_MAGIC */
+    uint32_t nodes_numof;               /**< number of node slots in use */
+    vradio_node_t nodes[VRADIO_MEDIUM_NODES_MAX];   /**< node slots */
+} vradio_medium_t;
+
+/**
+ * @brief   Get a pointer to the oldest frame in a ring
+ *
+ * @param[in] ring  ring to peek into (consumer side)
+ *
+ * @return  the oldest frame, valid until @ref vradio_ring_pop
+ * @return  NULL, if the ring is empty
+ */
+static inline vradio_frame_t *vradio_ring_peek(vradio_ring_t *ring)
+{
+    uint32_t tail = ring->tail;
+
+    if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail) {
+        return NULL;
+    }
+    return &ring->frames[tail & (VRADIO_RING_SIZE - 1)];
+}
+
+/**
+ * @brief   Release the oldest frame of a ring
+ *
+ * @pre @ref vradio_ring_peek returned a frame
+ *
+ * @param[in] ring  ring to release the frame of (consumer side)
+ */
+static inline void vradio_ring_pop(vradio_ring_t *ring)
+{
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief   Append a frame to a ring
+ *
+ * @param[in] ring  ring to append to (producer side)
+ * @param[in] frame frame to copy into the ring
+ *
+ * @return  0 on success
+ * @return  -1, if the ring is full
+ */
+static inline int vradio_ring_put(vradio_ring_t *ring,
+                                  const vradio_frame_t *frame)
+{
+    uint32_t head = ring->head;
+
+    if ((head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) >=
+        VRADIO_RING_SIZE) {
+        return -1;
+    }
+    ring->frames[head & (VRADIO_RING_SIZE - 1)] = *frame;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VRADIO_MEDIUM_H */
+/** @} */
@@ -40,6 +40,7 @@
 #include "periph/pm.h"
 
 #include "native_internal.h"
+#include "sched_trace.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -261,7 +262,9 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+            SCHED_TRACE(SCHED_TRACE_IRQ_ENTER, sched_active_pid, sig);
             native_irq_handlers[sig]();
+            SCHED_TRACE(SCHED_TRACE_IRQ_EXIT, sched_active_pid, sig);
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
@@ -542,6 +545,20 @@ void native_interrupt_init(void)
         err(EXIT_FAILURE, "native_interrupt_init: sigaction");
     }
 
+#ifdef MODULE_NATIVE_PROF
+    /* SIGPROF is never deferred like an interrupt, it samples whatever is
+     * running, including code with interrupts disabled */
+    sa.sa_sigaction = native_prof_sample;
+    if (sigdelset(&_native_sig_set, SIGPROF) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigdelset");
+    }
+    if (sigdelset(&_native_sig_set_dint, SIGPROF) == -1) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigdelset");
+    }
+    if (sigaction(SIGPROF, &sa, NULL)) {
+        err(EXIT_FAILURE, "native_interrupt_init: sigaction");
+    }
+#endif
 
     puts("RIOT native interrupts/signals initialized.");
 }
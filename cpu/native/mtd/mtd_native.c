@@ -17,8 +17,15 @@
 
 #include <stdio.h>
 #include <assert.h>
+#include <fcntl.h>
 #include <inttypes.h>
 #include <errno.h>
+#include <string.h>
+#ifdef MODULE_MTD_NATIVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "mtd.h"
 #include "mtd_native.h"
@@ -28,12 +35,199 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+typedef enum {
+    _OP_READ,
+    _OP_PROGRAM,
+    _OP_ERASE,
+} _op_t;
+
+static inline size_t _mtd_size(const mtd_dev_t *dev)
+{
+    return dev->sector_count * dev->pages_per_sector * dev->page_size;
+}
+
+static inline size_t _sector_size(const mtd_dev_t *dev)
+{
+    return dev->pages_per_sector * dev->page_size;
+}
+
+static void _account(mtd_native_dev_t *_dev, _op_t op, uint32_t addr,
+                     uint32_t size)
+{
+    mtd_native_stats_t *stats = &_dev->stats;
+    size_t sector_size = _sector_size(&_dev->dev);
+
+    if (size == 0) {
+        return;
+    }
+
+    switch (op) {
+        case _OP_READ:
+            stats->read_bytes += size;
+            break;
+        case _OP_PROGRAM:
+            stats->program_bytes += size;
+            break;
+        case _OP_ERASE:
+            stats->erase_bytes += size;
+            break;
+    }
+
+    if (stats->sectors == NULL) {
+        /* not initialized */
+        return;
+    }
+    for (size_t s = addr / sector_size; s <= (addr + size - 1) / sector_size; s++) {
+        mtd_native_sector_stats_t *sector = &stats->sectors[s];
+
+        switch (op) {
+            case _OP_READ:
+                sector->reads++;
+                break;
+            case _OP_PROGRAM:
+                sector->programs++;
+                break;
+            case _OP_ERASE:
+                sector->erases++;
+                break;
+        }
+    }
+}
+
+#ifdef MODULE_MTD_NATIVE_MMAP
+static int _init(mtd_dev_t *dev)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t size = _mtd_size(dev);
+    struct stat st;
+    int res = 0;
+
+    DEBUG("mtd_native: init, filename=%s (mmap)\n", _dev->fname);
+
+    if (_dev->map != NULL) {
+        /* already mapped */
+        return 0;
+    }
+
+    _native_syscall_enter();
+    if (_dev->stats.sectors == NULL) {
+        _dev->stats.sectors = real_calloc(dev->sector_count,
+                                          sizeof(mtd_native_sector_stats_t));
+    }
+    int fd = real_open(_dev->fname, O_RDWR | O_CREAT, 0644);
+    if ((_dev->stats.sectors == NULL) || (fd == -1) ||
+        (fstat(fd, &st) == -1) ||
+        (((size_t)st.st_size < size) && (ftruncate(fd, size) == -1))) {
+        res = -EIO;
+    }
+    else {
+        void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            res = -EIO;
+        }
+        else {
+            _dev->map = map;
+            if ((size_t)st.st_size < size) {
+                /* new flash is erased */
+                DEBUG("mtd_native: init: erasing new space in %s\n", _dev->fname);
+                memset(_dev->map + st.st_size, 0xff, size - st.st_size);
+            }
+        }
+    }
+    if (fd != -1) {
+        real_close(fd);
+    }
+    _native_syscall_leave();
+
+    return res;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+
+    DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (_dev->map == NULL) {
+        return -EIO;
+    }
+    if (addr + size > _mtd_size(dev)) {
+        return -EOVERFLOW;
+    }
+
+    memcpy(buff, _dev->map + addr, size);
+    _account(_dev, _OP_READ, addr, size);
+
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t sector_size = _sector_size(dev);
+    const uint8_t *src = buff;
+    uint8_t *dst;
+
+    DEBUG("mtd_native: write from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (_dev->map == NULL) {
+        return -EIO;
+    }
+    if (addr + size > _mtd_size(dev)) {
+        return -EOVERFLOW;
+    }
+    if (((addr % sector_size) + size) > sector_size) {
+        return -EOVERFLOW;
+    }
+
+    dst = _dev->map + addr;
+
+    /* programming can only clear bits */
+    for (uint32_t i = 0; i < size; i++) {
+        dst[i] &= src[i];
+    }
+    _account(_dev, _OP_PROGRAM, addr, size);
+
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
+    size_t sector_size = _sector_size(dev);
+
+    DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
+
+    if (_dev->map == NULL) {
+        return -EIO;
+    }
+    if (addr + size > _mtd_size(dev)) {
+        return -EOVERFLOW;
+    }
+    if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
+        return -EOVERFLOW;
+    }
+
+    memset(_dev->map + addr, 0xff, size);
+    _account(_dev, _OP_ERASE, addr, size);
+
+    return 0;
+}
+#else /* MODULE_MTD_NATIVE_MMAP */
 static int _init(mtd_dev_t *dev)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
 
     DEBUG("mtd_native: init, filename=%s\n", _dev->fname);
 
+    if (_dev->stats.sectors == NULL) {
+        _dev->stats.sectors = real_calloc(dev->sector_count,
+                                          sizeof(mtd_native_sector_stats_t));
+        if (_dev->stats.sectors == NULL) {
+            return -ENOMEM;
+        }
+    }
+
     FILE *f = real_fopen(_dev->fname, "r");
 
     if (!f) {
@@ -42,7 +236,7 @@ static int _init(mtd_dev_t *dev)
         if (!f) {
             return -EIO;
         }
-        size_t size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+        size_t size = _mtd_size(dev);
         for (size_t i = 0; i < size; i++) {
             real_fputc(0xff, f);
         }
@@ -56,7 +250,7 @@ static int _init(mtd_dev_t *dev)
 static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
+    size_t mtd_size = _mtd_size(dev);
 
     DEBUG("mtd_native: read from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
@@ -71,6 +265,7 @@ static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
     real_fseek(f, addr, SEEK_SET);
     size = real_fread(buff, 1, size, f);
     real_fclose(f);
+    _account(_dev, _OP_READ, addr, size);
 
     return size;
 }
@@ -78,8 +273,8 @@ static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
 static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-    size_t sector_size = dev->pages_per_sector * dev->page_size;
+    size_t mtd_size = _mtd_size(dev);
+    size_t sector_size = _sector_size(dev);
 
     DEBUG("mtd_native: write from page %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
@@ -101,6 +296,7 @@ static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size
         real_fputc(c & ((uint8_t*)buff)[i], f);
     }
     real_fclose(f);
+    _account(_dev, _OP_PROGRAM, addr, size);
 
     return size;
 }
@@ -108,8 +304,8 @@ static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size
 static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
 {
     mtd_native_dev_t *_dev = (mtd_native_dev_t*) dev;
-    size_t mtd_size = dev->sector_count * dev->pages_per_sector * dev->page_size;
-    size_t sector_size = dev->pages_per_sector * dev->page_size;
+    size_t mtd_size = _mtd_size(dev);
+    size_t sector_size = _sector_size(dev);
 
     DEBUG("mtd_native: erase from sector %" PRIu32 " count %" PRIu32 "\n", addr, size);
 
@@ -129,9 +325,11 @@ static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
         real_fputc(0xff, f);
     }
     real_fclose(f);
+    _account(_dev, _OP_ERASE, addr, size);
 
     return 0;
 }
+#endif /* MODULE_MTD_NATIVE_MMAP */
 
 static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 {
@@ -142,6 +340,46 @@ static int _power(mtd_dev_t *dev, enum mtd_power_state power)
 }
 
 
+void mtd_native_stats_reset(mtd_native_dev_t *dev)
+{
+    dev->stats.read_bytes = 0;
+    dev->stats.program_bytes = 0;
+    dev->stats.erase_bytes = 0;
+    if (dev->stats.sectors) {
+        memset(dev->stats.sectors, 0,
+               dev->dev.sector_count * sizeof(mtd_native_sector_stats_t));
+    }
+}
+
+void mtd_native_stats_print(const mtd_native_dev_t *dev)
+{
+    const mtd_native_stats_t *stats = &dev->stats;
+    uint32_t max_erases = 0, max_sector = 0;
+
+    printf("mtd_native: read %" PRIu64 " B, programmed %" PRIu64
+           " B, erased %" PRIu64 " B\n", stats->read_bytes,
+           stats->program_bytes, stats->erase_bytes);
+    if (stats->sectors == NULL) {
+        return;
+    }
+
+    printf("%8s %10s %10s %10s\n", "sector", "reads", "programs", "erases");
+    for (uint32_t s = 0; s < dev->dev.sector_count; s++) {
+        const mtd_native_sector_stats_t *sector = &stats->sectors[s];
+
+        if (sector->erases > max_erases) {
+            max_erases = sector->erases;
+            max_sector = s;
+        }
+        if (sector->reads || sector->programs || sector->erases) {
+            printf("%8" PRIu32 " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 "\n",
+                   s, sector->reads, sector->programs, sector->erases);
+        }
+    }
+    printf("mtd_native: max. erase count %" PRIu32 " (sector %" PRIu32 ")\n",
+           max_erases, max_sector);
+}
+
 const mtd_desc_t native_flash_driver = {
     .read = _read,
     .power = _power,
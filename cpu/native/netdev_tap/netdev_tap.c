@@ -21,6 +21,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -45,6 +46,9 @@
 #include <net/if.h>
 #include <linux/if_tun.h>
 #include <linux/if_ether.h>
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+#include <linux/virtio_net.h>
+#endif
 #endif
 
 #include "native_internal.h"
@@ -59,6 +63,23 @@
 #include "netdev_tap.h"
 #include "net/netopt.h"
 
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+#include "net/ethertype.h"
+#include "net/icmpv6.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "net/udp.h"
+#endif
+
+#if defined(MODULE_NETDEV_TAP_MQ) && (defined(__MACH__) || defined(__FreeBSD__))
+#error "netdev_tap_mq is only supported on Linux"
+#endif
+
+#if defined(MODULE_NETDEV_TAP_VNET_HDR) && (defined(__MACH__) || defined(__FreeBSD__))
+#error "netdev_tap_vnet_hdr is only supported on Linux"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -92,10 +113,34 @@ static inline int _set_promiscous(netdev_t *netdev, int value)
     return value;
 }
 
+#ifdef MODULE_NETDEV_TAP_BATCH
+static void _rx_drain(netdev_tap_t *dev);
+static void _continue_reading(netdev_tap_t *dev);
+#endif
+
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+static int _set_rx_csum_offload(netdev_tap_t *dev, bool enable);
+#endif
+
 static inline void _isr(netdev_t *netdev)
 {
     if (netdev->event_callback) {
+#ifdef MODULE_NETDEV_TAP_BATCH
+        netdev_tap_t *dev = (netdev_tap_t*)netdev;
+
+        _rx_drain(dev);
+        while (dev->rx_head < dev->rx_numof) {
+            uint8_t head = dev->rx_head;
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+            if (dev->rx_head == head) {
+                /* upper layer did not fetch the frame, drop it */
+                dev->rx_head++;
+            }
+        }
+        _continue_reading(dev);
+#else
         netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+#endif
     }
 #if DEVELHELP
     else {
@@ -122,6 +167,20 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+        case NETOPT_RX_CHECKSUM_OFFLOAD:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = ((netdev_tap_t *)dev)->rx_csum_offload ?
+                                          NETOPT_ENABLE : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
+        case NETOPT_TX_CHECKSUM_OFFLOAD:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = ((netdev_tap_t *)dev)->tx_csum_offload ?
+                                          NETOPT_ENABLE : NETOPT_DISABLE;
+            res = sizeof(netopt_enable_t);
+            break;
+#endif
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
@@ -143,6 +202,19 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
         case NETOPT_PROMISCUOUSMODE:
             _set_promiscous(dev, ((const bool *)value)[0]);
             break;
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+        case NETOPT_RX_CHECKSUM_OFFLOAD:
+            assert(value_len >= sizeof(netopt_enable_t));
+            res = _set_rx_csum_offload((netdev_tap_t *)dev,
+                                       *((const netopt_enable_t *)value) == NETOPT_ENABLE);
+            break;
+        case NETOPT_TX_CHECKSUM_OFFLOAD:
+            assert(value_len >= sizeof(netopt_enable_t));
+            ((netdev_tap_t *)dev)->tx_csum_offload =
+                (*((const netopt_enable_t *)value) == NETOPT_ENABLE);
+            res = sizeof(netopt_enable_t);
+            break;
+#endif
         default:
             res = netdev_eth_set(dev, opt, value, value_len);
             break;
@@ -173,18 +245,208 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
+static inline bool _is_addr_for_me(netdev_tap_t *dev, uint8_t *addr)
+{
+    return dev->promiscous || _is_addr_multicast(addr) ||
+           _is_addr_broadcast(addr) ||
+           (memcmp(addr, dev->addr, ETHERNET_ADDR_LEN) == 0);
+}
+
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+/* a transport layer header directly following the IPv6 header starts here */
+#define L4_OFFSET   (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t))
+
+/* offset of the checksum field in the transport layer headers the driver
+ * offloads checksums of, -1 for all other protocols */
+static int _csum_offset(uint8_t protnum)
+{
+    switch (protnum) {
+        case PROTNUM_ICMPV6:
+            return offsetof(icmpv6_hdr_t, csum);
+        case PROTNUM_TCP:
+            return offsetof(tcp_hdr_t, checksum);
+        case PROTNUM_UDP:
+            return offsetof(udp_hdr_t, checksum);
+        default:
+            return -1;
+    }
+}
+
+/* protocol number of the transport layer message directly following the IPv6
+ * header of a frame, if the driver offloads its checksum */
+static uint8_t _l4_protnum(const uint8_t *frame, size_t len)
+{
+    const ethernet_hdr_t *eth = (const ethernet_hdr_t *)frame;
+    const ipv6_hdr_t *ipv6 = (const ipv6_hdr_t *)(frame + sizeof(ethernet_hdr_t));
+
+    if ((len < L4_OFFSET) || (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+        (_csum_offset(ipv6->nh) < 0)) {
+        return PROTNUM_RESERVED;
+    }
+    return ipv6->nh;
+}
+
+static bool _rx_csum_valid(uint8_t *frame, size_t len)
+{
+    uint8_t protnum = _l4_protnum(frame, len);
+
+    if (protnum == PROTNUM_RESERVED) {
+        /* left to the network stack */
+        return true;
+    }
+
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(frame + sizeof(ethernet_hdr_t));
+    uint16_t l4_len = byteorder_ntohs(ipv6->len);
+
+    if ((L4_OFFSET + l4_len) > len) {
+        return false;
+    }
+    uint16_t csum = ipv6_hdr_inet_csum(0, ipv6, protnum, l4_len);
+    return inet_csum(csum, frame + L4_OFFSET, l4_len) == 0xffff;
+}
+
+/* completes a partial checksum, i.e. the sum over the pseudo-header, at
+ * csum_offset from csum_start with the sum over all data from csum_start */
+static int _rx_csum_complete(uint8_t *frame, size_t len, size_t csum_start,
+                             size_t csum_offset)
+{
+    if ((csum_start + csum_offset + sizeof(network_uint16_t)) > len) {
+        return -1;
+    }
+
+    uint16_t csum = ~inet_csum(0, frame + csum_start, len - csum_start);
+
+    if (csum == 0) {
+        /* 0 marks a UDP datagram without checksum */
+        csum = 0xffff;
+    }
+    network_uint16_t field = byteorder_htons(csum);
+    memcpy(frame + csum_start + csum_offset, &field, sizeof(field));
+    return 0;
+}
+
+static int _set_rx_csum_offload(netdev_tap_t *dev, bool enable)
+{
+    /* allow the host to send partial checksums only if the upper layer does
+     * not verify them, they are completed on reception */
+    unsigned long offload = enable ? TUN_F_CSUM : 0;
+
+    if (real_ioctl(dev->tap_fd, TUNSETOFFLOAD, offload) == -1) {
+        return -errno;
+    }
+    dev->rx_csum_offload = enable;
+    return sizeof(netopt_enable_t);
+}
+
+/* asks the host to complete the checksum of a frame if its checksum field
+ * holds just the sum over the pseudo-header */
+static void _tx_vnet_hdr(netdev_tap_t *dev, struct virtio_net_hdr *vnet,
+                         const struct iovec *vector, unsigned n)
+{
+    uint8_t hdr[L4_OFFSET + sizeof(tcp_hdr_t)];
+    size_t len = 0;
+
+    memset(vnet, 0, sizeof(*vnet));
+    if (!dev->tx_csum_offload) {
+        return;
+    }
+
+    for (unsigned i = 0; (i < n) && (len < sizeof(hdr)); i++) {
+        size_t cpy = sizeof(hdr) - len;
+
+        if (vector[i].iov_len < cpy) {
+            cpy = vector[i].iov_len;
+        }
+        memcpy(&hdr[len], vector[i].iov_base, cpy);
+        len += cpy;
+    }
+
+    uint8_t protnum = _l4_protnum(hdr, len);
+    if (protnum == PROTNUM_RESERVED) {
+        return;
+    }
+
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(hdr + sizeof(ethernet_hdr_t));
+    int offset = _csum_offset(protnum);
+    network_uint16_t field;
+
+    if ((L4_OFFSET + offset + sizeof(field)) > len) {
+        return;
+    }
+    memcpy(&field, &hdr[L4_OFFSET + offset], sizeof(field));
+    /* a complete checksum (e.g. of a forwarded packet) only matches if
+     * completing it again yields the same value */
+    if (byteorder_ntohs(field) == ipv6_hdr_inet_csum(0, ipv6, protnum,
+                                                     byteorder_ntohs(ipv6->len))) {
+        vnet->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+        vnet->csum_start = L4_OFFSET;
+        vnet->csum_offset = offset;
+    }
+}
+#endif
+
+/* reads a single frame from a queue of the TAP, fails with EBADMSG if the
+ * frame has an invalid checksum */
+static ssize_t _read_frame(netdev_tap_t *dev, int fd, void *buf, size_t len)
+{
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+    struct virtio_net_hdr vnet;
+    struct iovec iov[] = {
+        { .iov_base = &vnet, .iov_len = sizeof(vnet) },
+        { .iov_base = buf, .iov_len = len },
+    };
+    ssize_t nread = real_readv(fd, iov, 2);
+
+    if (nread < (ssize_t)sizeof(vnet)) {
+        return (nread < 0) ? nread : 0;
+    }
+    nread -= sizeof(vnet);
+
+    if (vnet.flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
+        /* the host sent this frame itself and left its checksum to us, the
+         * frame may be forwarded so the checksum is completed right away */
+        if (_rx_csum_complete(buf, nread, vnet.csum_start,
+                              vnet.csum_offset) < 0) {
+            errno = EBADMSG;
+            return -1;
+        }
+    }
+    /* the host flags frames it verified, all others (e.g. bridged from
+     * another TAP) are verified here */
+    else if (dev->rx_csum_offload &&
+             !(vnet.flags & VIRTIO_NET_HDR_F_DATA_VALID) &&
+             !_rx_csum_valid(buf, nread)) {
+        errno = EBADMSG;
+        return -1;
+    }
+    return nread;
+#else
+    (void)dev;
+    return real_read(fd, buf, len);
+#endif
+}
+
 static void _continue_reading(netdev_tap_t *dev)
 {
     /* work around lost signals */
     fd_set rfds;
     struct timeval t;
+    int max_fd = dev->tap_fd;
     memset(&t, 0, sizeof(t));
     FD_ZERO(&rfds);
     FD_SET(dev->tap_fd, &rfds);
+#ifdef MODULE_NETDEV_TAP_MQ
+    for (unsigned i = 1; i < NETDEV_TAP_QUEUES; i++) {
+        FD_SET(dev->queue_fds[i], &rfds);
+        if (dev->queue_fds[i] > max_fd) {
+            max_fd = dev->queue_fds[i];
+        }
+    }
+#endif
 
     _native_in_syscall++; /* no switching here */
 
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+    if (real_select(max_fd + 1, &rfds, NULL, NULL, &t) > 0) {
         int sig = SIGIO;
         extern int _sig_pipefd[2];
         extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
@@ -200,6 +462,83 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+#ifdef MODULE_NETDEV_TAP_BATCH
+/* reads from one queue until it is empty or the RX ring is full, returns
+ * false if the ring is full */
+static bool _rx_drain_fd(netdev_tap_t *dev, int fd)
+{
+    while (dev->rx_numof < NETDEV_TAP_RX_RING) {
+        uint8_t *frame = dev->rx_ring[dev->rx_numof];
+        int nread = _read_frame(dev, fd, frame, ETHERNET_FRAME_LEN);
+
+        if ((nread == -1) && (errno == EBADMSG)) {
+            DEBUG("netdev_tap: invalid checksum => dropped\n");
+            continue;
+        }
+        if (nread <= 0) {
+            if ((nread == -1) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                err(EXIT_FAILURE, "netdev_tap: read");
+            }
+            return true;
+        }
+        if (!_is_addr_for_me(dev, ((ethernet_hdr_t *)frame)->dst)) {
+            DEBUG("netdev_tap: not for me => dropped\n");
+            continue;
+        }
+        dev->rx_len[dev->rx_numof++] = nread;
+    }
+    return false;
+}
+
+/* reads all pending frames (up to NETDEV_TAP_RX_RING) into the RX ring */
+static void _rx_drain(netdev_tap_t *dev)
+{
+    dev->rx_head = 0;
+    dev->rx_numof = 0;
+#ifdef MODULE_NETDEV_TAP_MQ
+    for (unsigned i = 0; i < NETDEV_TAP_QUEUES; i++) {
+        if (!_rx_drain_fd(dev, dev->queue_fds[i])) {
+            break;
+        }
+    }
+#else
+    _rx_drain_fd(dev, dev->tap_fd);
+#endif
+    DEBUG("netdev_tap: drained %u frames\n", (unsigned)dev->rx_numof);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    (void)info;
+
+    if (dev->rx_head >= dev->rx_numof) {
+        return -1;
+    }
+
+    int size = dev->rx_len[dev->rx_head];
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            dev->rx_head++;
+        }
+        return size;
+    }
+
+    if ((size_t)size > len) {
+        dev->rx_head++;
+        return -ENOBUFS;
+    }
+
+    memcpy(buf, dev->rx_ring[dev->rx_head++], size);
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += size;
+#endif
+    return size;
+}
+#else
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -230,14 +569,12 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
         return ETHERNET_FRAME_LEN;
     }
 
-    int nread = real_read(dev->tap_fd, buf, len);
+    int nread = _read_frame(dev, dev->tap_fd, buf, len);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
     if (nread > 0) {
         ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+        if (!_is_addr_for_me(dev, hdr->dst)) {
             DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
                   "That's not me => Dropped\n",
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
@@ -259,6 +596,11 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     else if (nread == -1) {
         if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
         }
+        else if (errno == EBADMSG) {
+            DEBUG("netdev_tap: invalid checksum => dropped\n");
+            native_async_read_continue(dev->tap_fd);
+            return 0;
+        }
         else {
             err(EXIT_FAILURE, "netdev_tap: read");
         }
@@ -272,11 +614,26 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
     return -1;
 }
+#endif
 
 static int _send(netdev_t *netdev, const struct iovec *vector, unsigned n)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+    struct virtio_net_hdr vnet;
+    struct iovec iov[n + 1];
+
+    _tx_vnet_hdr(dev, &vnet, vector, n);
+    iov[0].iov_base = &vnet;
+    iov[0].iov_len = sizeof(vnet);
+    memcpy(&iov[1], vector, n * sizeof(struct iovec));
+    int res = _native_writev(dev->tap_fd, iov, n + 1);
+    if (res > 0) {
+        res -= sizeof(vnet);
+    }
+#else
     int res = _native_writev(dev->tap_fd, vector, n);
+#endif
 #ifdef MODULE_NETSTATS_L2
     size_t bytes = 0;
     for (unsigned i = 0; i < n; i++) {
@@ -333,6 +690,10 @@ static int _init(netdev_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+    dev->rx_csum_offload = 0;
+    dev->tx_csum_offload = 0;
+#endif
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
@@ -352,6 +713,12 @@ static int _init(netdev_t *netdev)
 #else /* Linux */
     memset(&ifr, 0, sizeof(ifr));
     ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+#ifdef MODULE_NETDEV_TAP_MQ
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+#endif
+#ifdef MODULE_NETDEV_TAP_VNET_HDR
+    ifr.ifr_flags |= IFF_VNET_HDR;
+#endif
     strncpy(ifr.ifr_name, name, IFNAMSIZ);
     if (real_ioctl(dev->tap_fd, TUNSETIFF, (void *)&ifr) == -1) {
         _native_in_syscall++;
@@ -360,6 +727,22 @@ static int _init(netdev_t *netdev)
         real_exit(EXIT_FAILURE);
     }
 
+#ifdef MODULE_NETDEV_TAP_MQ
+    /* attach the remaining queues to the same interface */
+    dev->queue_fds[0] = dev->tap_fd;
+    for (unsigned i = 1; i < NETDEV_TAP_QUEUES; i++) {
+        if ((dev->queue_fds[i] = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
+            err(EXIT_FAILURE, "open(%s)", clonedev);
+        }
+        if (real_ioctl(dev->queue_fds[i], TUNSETIFF, (void *)&ifr) == -1) {
+            _native_in_syscall++;
+            warn("ioctl TUNSETIFF");
+            warnx("probably the tap interface (%s) is not a multi-queue interface", name);
+            real_exit(EXIT_FAILURE);
+        }
+    }
+#endif
+
     /* get MAC address */
     memset(&ifr, 0, sizeof(ifr));
     snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", name);
@@ -382,7 +765,13 @@ static int _init(netdev_t *netdev)
 
     /* configure signal handler for fds */
     native_async_read_setup();
+#ifdef MODULE_NETDEV_TAP_MQ
+    for (unsigned i = 0; i < NETDEV_TAP_QUEUES; i++) {
+        native_async_read_add_handler(dev->queue_fds[i], netdev, _tap_isr);
+    }
+#else
     native_async_read_add_handler(dev->tap_fd, netdev, _tap_isr);
+#endif
 
 #ifdef MODULE_NETSTATS_L2
     memset(&netdev->stats, 0, sizeof(netstats_t));
@@ -0,0 +1,506 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     netdev
+ * @{
+ *
+ * @file
+ * @brief       IEEE 802.15.4 driver for native on a shared memory medium
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* needs to be included before native's declarations of ntohl etc. */
+#include "byteorder.h"
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "native_internal.h"
+
+#include "async_read.h"
+#include "net/ieee802154.h"
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+#include "netdev_vradio.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _MAX_MHR_OVERHEAD   (25)
+
+static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count);
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info);
+static int _init(netdev_t *netdev);
+static void _isr(netdev_t *netdev);
+static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len);
+static int _set(netdev_t *netdev, netopt_t opt, const void *val, size_t len);
+
+static const netdev_driver_t netdev_driver_vradio = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+void netdev_vradio_setup(netdev_vradio_t *dev,
+                         const netdev_vradio_params_t *params)
+{
+    memset(dev, 0, sizeof(*dev));
+    dev->netdev.netdev.driver = &netdev_driver_vradio;
+    dev->params = *params;
+    dev->sock = -1;
+}
+
+static inline unsigned _node_num(const netdev_vradio_t *dev)
+{
+    return dev->params.node;
+}
+
+static inline bool _rx_on(netopt_state_t state)
+{
+    return (state == NETOPT_STATE_IDLE) || (state == NETOPT_STATE_RX);
+}
+
+static void _attach(netdev_vradio_t *dev)
+{
+    const netdev_vradio_params_t *p = &dev->params;
+    struct sockaddr_un addr;
+    char shm_name[64];
+    int fd;
+
+    _native_syscall_enter();
+
+    if (p->node >= VRADIO_MEDIUM_NODES_MAX) {
+        errx(EXIT_FAILURE, "netdev_vradio: node %u out of range (max. %u)",
+             p->node, VRADIO_MEDIUM_NODES_MAX - 1);
+    }
+
+    /* map the medium created by the daemon */
+    snprintf(shm_name, sizeof(shm_name), VRADIO_SHM_FMT, p->medium);
+    if ((fd = shm_open(shm_name, O_RDWR, 0)) == -1) {
+        warn("shm_open(%s)", shm_name);
+        errx(EXIT_FAILURE, "probably vradiod is not running for medium %s",
+             p->medium);
+    }
+    dev->medium = mmap(NULL, sizeof(vradio_medium_t), PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+    real_close(fd);
+    if (dev->medium == MAP_FAILED) {
+        err(EXIT_FAILURE, "mmap(%s)", shm_name);
+    }
+    if (dev->medium->magic != VRADIO_MEDIUM_MAGIC) {
+        errx(EXIT_FAILURE, "netdev_vradio: %s is no vradio medium", shm_name);
+    }
+    if (p->node >= dev->medium->nodes_numof) {
+        errx(EXIT_FAILURE, "netdev_vradio: medium %s only has %u nodes",
+             p->medium, (unsigned)dev->medium->nodes_numof);
+    }
+    dev->node = &dev->medium->nodes[p->node];
+
+    /* discard frames left over for a previous instance on this node */
+    __atomic_store_n(&dev->node->rx.tail,
+                     __atomic_load_n(&dev->node->rx.head, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&dev->node->pid, (uint32_t)_native_pid, __ATOMIC_RELEASE);
+
+    /* the socket is bound to the node's path and connected to the daemon, so
+     * it only receives the daemon's notifications */
+    if ((dev->sock = real_socket(AF_UNIX, SOCK_DGRAM, 0)) == -1) {
+        err(EXIT_FAILURE, "netdev_vradio: socket");
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), VRADIO_NODE_SOCK_FMT,
+             p->medium, p->node);
+    real_unlink(addr.sun_path);
+    if (real_bind(dev->sock, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        err(EXIT_FAILURE, "netdev_vradio: bind(%s)", addr.sun_path);
+    }
+    snprintf(addr.sun_path, sizeof(addr.sun_path), VRADIO_DAEMON_SOCK_FMT,
+             p->medium);
+    if (connect(dev->sock, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        err(EXIT_FAILURE, "netdev_vradio: connect(%s)", addr.sun_path);
+    }
+
+    _native_syscall_leave();
+}
+
+static void _kick(netdev_vradio_t *dev)
+{
+    const uint8_t kick = 0;
+
+    _native_syscall_enter();
+    if (real_write(dev->sock, &kick, sizeof(kick)) == -1) {
+        DEBUG("netdev_vradio: unable to notify daemon (%d)\n", errno);
+    }
+    _native_syscall_leave();
+}
+
+static void _set_addr(netdev_vradio_t *dev)
+{
+    unsigned node = _node_num(dev);
+
+    /* locally administered unicast address, last bytes hold the node */
+    memset(dev->netdev.long_addr, 0, sizeof(dev->netdev.long_addr));
+    dev->netdev.long_addr[0] = 0x02;
+    dev->netdev.long_addr[6] = (uint8_t)(node >> 8);
+    dev->netdev.long_addr[7] = (uint8_t)node;
+    /* https://tools.ietf.org/html/rfc4944#section-12 requires the first bit
+     * to be 0 for unicast addresses */
+    dev->netdev.short_addr[0] = (uint8_t)(node >> 8) & 0x7f;
+    dev->netdev.short_addr[1] = (uint8_t)node;
+}
+
+static void _set_rx(netdev_vradio_t *dev, netopt_state_t state)
+{
+    dev->state = state;
+    __atomic_store_n(&dev->node->rx_on, _rx_on(state), __ATOMIC_RELEASE);
+}
+
+static void _reset(netdev_vradio_t *dev)
+{
+    dev->netdev.seq = 0;
+    dev->netdev.flags = 0;
+    _set_addr(dev);
+    dev->netdev.pan = IEEE802154_DEFAULT_PANID;
+    dev->netdev.chan = IEEE802154_DEFAULT_CHANNEL;
+    __atomic_store_n(&dev->node->channel, dev->netdev.chan, __ATOMIC_RELEASE);
+#ifdef MODULE_GNRC_SIXLOWPAN
+    dev->netdev.proto = GNRC_NETTYPE_SIXLOWPAN;
+#elif MODULE_GNRC
+    dev->netdev.proto = GNRC_NETTYPE_UNDEF;
+#endif
+    dev->preloading = false;
+    dev->promiscuous = false;
+    dev->tell_rx_start = false;
+    dev->tell_tx_start = false;
+    dev->tx_frame.len = 0;
+    _set_rx(dev, NETOPT_STATE_IDLE);
+}
+
+static void _vradio_isr(int fd, void *arg)
+{
+    (void)fd;
+    netdev_t *netdev = (netdev_t *)arg;
+
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_ISR);
+    }
+    else {
+        puts("netdev_vradio: _isr: no event callback.");
+    }
+}
+
+static int _init(netdev_t *netdev)
+{
+    netdev_vradio_t *dev = (netdev_vradio_t *)netdev;
+
+    _attach(dev);
+    _reset(dev);
+
+    native_async_read_setup();
+    native_async_read_add_handler(dev->sock, netdev, _vradio_isr);
+
+#ifdef MODULE_NETSTATS_L2
+    memset(&netdev->stats, 0, sizeof(netstats_t));
+#endif
+    DEBUG("netdev_vradio: attached as node %u to medium %s\n",
+          _node_num(dev), dev->params.medium);
+    return 0;
+}
+
+static void _transmit(netdev_vradio_t *dev)
+{
+    netdev_t *netdev = (netdev_t *)dev;
+
+    if (dev->tell_tx_start && netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_TX_STARTED);
+    }
+
+    dev->tx_frame.channel = dev->netdev.chan;
+    if (vradio_ring_put(&dev->node->tx, &dev->tx_frame) < 0) {
+        DEBUG("netdev_vradio: TX ring full\n");
+        if (netdev->event_callback) {
+            netdev->event_callback(netdev, NETDEV_EVENT_TX_MEDIUM_BUSY);
+        }
+        return;
+    }
+    _kick(dev);
+
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV_EVENT_TX_COMPLETE);
+    }
+}
+
+static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
+{
+    netdev_vradio_t *dev = (netdev_vradio_t *)netdev;
+    size_t len = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+        if ((len + vector[i].iov_len) > VRADIO_FRAME_MAX) {
+            DEBUG("netdev_vradio: frame too large (%u byte)\n",
+                  (unsigned)(len + vector[i].iov_len));
+            return -EOVERFLOW;
+        }
+        memcpy(&dev->tx_frame.data[len], vector[i].iov_base,
+               vector[i].iov_len);
+        len += vector[i].iov_len;
+    }
+    dev->tx_frame.len = (uint8_t)len;
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
+
+    /* send data out directly if pre-loading is disabled */
+    if (!dev->preloading) {
+        _transmit(dev);
+    }
+    return (int)len;
+}
+
+/* hardware address filter of a real transceiver */
+static bool _accept(const netdev_vradio_t *dev, const vradio_frame_t *frame)
+{
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t dst_pan;
+    uint16_t pan;
+
+    if (!_rx_on(dev->state) || (frame->channel != dev->netdev.chan)) {
+        return false;
+    }
+    if (dev->promiscuous) {
+        return true;
+    }
+    if (frame->len < (IEEE802154_FCF_LEN + 1)) {
+        return false;
+    }
+
+    switch (ieee802154_get_dst(frame->data, dst, &dst_pan)) {
+        case 0:
+            /* no destination, e.g. a beacon */
+            return true;
+        case IEEE802154_SHORT_ADDRESS_LEN:
+            if (memcmp(dst, ieee802154_addr_bcast, IEEE802154_ADDR_BCAST_LEN) &&
+                memcmp(dst, dev->netdev.short_addr, IEEE802154_SHORT_ADDRESS_LEN)) {
+                return false;
+            }
+            break;
+        case IEEE802154_LONG_ADDRESS_LEN:
+            if (memcmp(dst, dev->netdev.long_addr, IEEE802154_LONG_ADDRESS_LEN)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    pan = byteorder_ntohs(byteorder_ltobs(dst_pan));
+    return (pan == dev->netdev.pan) || (pan == 0xffff);
+}
+
+static void _isr(netdev_t *netdev)
+{
+    netdev_vradio_t *dev = (netdev_vradio_t *)netdev;
+    vradio_frame_t *frame;
+    uint8_t kick[8];
+
+    /* consume the notifications before looking at the ring, a frame put into
+     * the ring afterwards comes with a new notification */
+    _native_syscall_enter();
+    while (real_read(dev->sock, kick, sizeof(kick)) > 0) {}
+    _native_syscall_leave();
+
+    while ((frame = vradio_ring_peek(&dev->node->rx)) != NULL) {
+        uint32_t tail = dev->node->rx.tail;
+
+        if (!_accept(dev, frame) || !netdev->event_callback) {
+            vradio_ring_pop(&dev->node->rx);
+            continue;
+        }
+        if (dev->tell_rx_start) {
+            netdev->event_callback(netdev, NETDEV_EVENT_RX_STARTED);
+        }
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        if (dev->node->rx.tail == tail) {
+            /* upper layer did not fetch the frame, drop it */
+            vradio_ring_pop(&dev->node->rx);
+        }
+    }
+
+    native_async_read_continue(dev->sock);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev_vradio_t *dev = (netdev_vradio_t *)netdev;
+    vradio_frame_t *frame = vradio_ring_peek(&dev->node->rx);
+    size_t pkt_len;
+
+    if (frame == NULL) {
+        return 0;
+    }
+    pkt_len = frame->len;
+
+    /* just return length when buf == NULL, drop the frame if len > 0 */
+    if (buf == NULL) {
+        if (len > 0) {
+            vradio_ring_pop(&dev->node->rx);
+        }
+        return pkt_len;
+    }
+    if (pkt_len > len) {
+        vradio_ring_pop(&dev->node->rx);
+        return -ENOBUFS;
+    }
+
+    memcpy(buf, frame->data, pkt_len);
+    if (info != NULL) {
+        netdev_ieee802154_rx_info_t *radio_info = info;
+        radio_info->rssi = frame->rssi;
+        radio_info->lqi = frame->lqi;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += pkt_len;
+#endif
+    vradio_ring_pop(&dev->node->rx);
+
+    return pkt_len;
+}
+
+static int _get_enable(void *val, size_t max_len, bool enable)
+{
+    assert(max_len >= sizeof(netopt_enable_t));
+    (void)max_len;
+    *((netopt_enable_t *)val) = enable ? NETOPT_ENABLE : NETOPT_DISABLE;
+    return sizeof(netopt_enable_t);
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
+{
+    netdev_vradio_t *dev = (netdev_vradio_t *)netdev;
+
+    switch (opt) {
+        case NETOPT_STATE:
+            assert(max_len >= sizeof(netopt_state_t));
+            *((netopt_state_t *)val) = dev->state;
+            return sizeof(netopt_state_t);
+        case NETOPT_MAX_PACKET_SIZE:
+            assert(max_len >= sizeof(uint16_t));
+            *((uint16_t *)val) = VRADIO_FRAME_MAX - _MAX_MHR_OVERHEAD;
+            return sizeof(uint16_t);
+        case NETOPT_TX_POWER:
+            assert(max_len >= sizeof(int16_t));
+            *((int16_t *)val) = 0;
+            return sizeof(int16_t);
+        case NETOPT_PRELOADING:
+            return _get_enable(val, max_len, dev->preloading);
+        case NETOPT_PROMISCUOUSMODE:
+            return _get_enable(val, max_len, dev->promiscuous);
+        case NETOPT_RX_START_IRQ:
+            return _get_enable(val, max_len, dev->tell_rx_start);
+        case NETOPT_TX_START_IRQ:
+            return _get_enable(val, max_len, dev->tell_tx_start);
+        case NETOPT_RX_END_IRQ:
+        case NETOPT_TX_END_IRQ:
+            return _get_enable(val, max_len, true);
+        case NETOPT_AUTOACK:
+        case NETOPT_CSMA:
+            return _get_enable(val, max_len, false);
+        default:
+            return netdev_ieee802154_get((netdev_ieee802154_t *)netdev, opt,
+                                         val, max_len);
+    }
+}
+
+static int _set_state(netdev_vradio_t *dev, netopt_state_t state)
+{
+    switch (state) {
+        case NETOPT_STATE_OFF:
+        case NETOPT_STATE_SLEEP:
+        case NETOPT_STATE_STANDBY:
+            _set_rx(dev, state);
+            break;
+        case NETOPT_STATE_IDLE:
+        case NETOPT_STATE_RX:
+            _set_rx(dev, NETOPT_STATE_IDLE);
+            break;
+        case NETOPT_STATE_TX:
+            if (dev->preloading) {
+                _transmit(dev);
+            }
+            break;
+        case NETOPT_STATE_RESET:
+            _reset(dev);
+            break;
+        default:
+            return -ENOTSUP;
+    }
+    return sizeof(netopt_state_t);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *val, size_t len)
+{
+    netdev_vradio_t *dev = (netdev_vradio_t *)netdev;
+    bool enable = false;
+
+    if (len >= sizeof(netopt_enable_t)) {
+        enable = (*((const netopt_enable_t *)val) == NETOPT_ENABLE);
+    }
+
+    switch (opt) {
+        case NETOPT_CHANNEL: {
+            assert(len == sizeof(uint16_t));
+            uint16_t chan = *((const uint16_t *)val);
+            if ((chan < IEEE802154_CHANNEL_MIN) ||
+                (chan > IEEE802154_CHANNEL_MAX)) {
+                return -EINVAL;
+            }
+            __atomic_store_n(&dev->node->channel, (uint8_t)chan,
+                             __ATOMIC_RELEASE);
+            /* the generic handler stores the channel in the netdev */
+            return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt,
+                                         val, len);
+        }
+        case NETOPT_STATE:
+            assert(len >= sizeof(netopt_state_t));
+            return _set_state(dev, *((const netopt_state_t *)val));
+        case NETOPT_PRELOADING:
+            dev->preloading = enable;
+            return sizeof(netopt_enable_t);
+        case NETOPT_PROMISCUOUSMODE:
+            dev->promiscuous = enable;
+            return sizeof(netopt_enable_t);
+        case NETOPT_RX_START_IRQ:
+            dev->tell_rx_start = enable;
+            return sizeof(netopt_enable_t);
+        case NETOPT_TX_START_IRQ:
+            dev->tell_tx_start = enable;
+            return sizeof(netopt_enable_t);
+        case NETOPT_RX_END_IRQ:
+        case NETOPT_TX_END_IRQ:
+            /* always signalled */
+            return sizeof(netopt_enable_t);
+        default:
+            return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt,
+                                         val, len);
+    }
+}
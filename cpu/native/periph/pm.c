@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "irq.h"
 #include "periph/pm.h"
 #include "native_internal.h"
 #include "async_read.h"
@@ -31,6 +32,17 @@
 
 void pm_set_lowest(void)
 {
+#ifdef MODULE_NATIVE_VTIME
+    /* let virtual time jump to the next timer deadline instead of waiting,
+     * enabling interrupts again raises the timer interrupt */
+    unsigned state = irq_disable();
+    bool advanced = native_vtime_advance();
+    irq_restore(state);
+    if (advanced) {
+        return;
+    }
+#endif
+
     _native_in_syscall++; // no switching here
     real_pause();
     _native_in_syscall--;
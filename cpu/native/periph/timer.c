@@ -20,6 +20,14 @@
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
  * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
+ * With the module `native_hrtimer`, every channel is backed by a POSIX timer
+ * on CLOCK_MONOTONIC, armed with an absolute deadline, and the lateness of
+ * every timer interrupt is recorded.
+ *
+ * With the module `native_vtime` on top, the timer runs on a virtual clock:
+ * the host clock plus an offset, which grows whenever the idle thread lets
+ * the clock jump to the next deadline instead of waiting for it.
+ *
  * @author      Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
@@ -45,12 +53,18 @@
 
 #include "cpu.h"
 #include "cpu_conf.h"
+#include "irq.h"
 #include "native_internal.h"
 #include "periph/timer.h"
+#include "timex.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if defined(MODULE_NATIVE_HRTIMER) && defined(__MACH__)
+#error "native_hrtimer is not supported on OS X"
+#endif
+
 #define NATIVE_TIMER_SPEED 1000000
 
 static unsigned long time_null;
@@ -58,7 +72,24 @@ static unsigned long time_null;
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+#ifdef MODULE_NATIVE_HRTIMER
+#define NS_PER_SEC  (1000000000LLU)
+
+typedef struct {
+    timer_t timer;          /**< host timer of the channel */
+    uint64_t deadline;      /**< CLOCK_MONOTONIC time the channel fires at in
+                                 ns, 0 if not set */
+} _channel_t;
+
+static _channel_t _channels[TIMER_0_CHANNELS];
+static bool _timers_created;
+static native_timer_jitter_t _jitter;
+#ifdef MODULE_NATIVE_VTIME
+static uint64_t _vtime_offset;  /**< virtual clock - host clock in us */
+#endif
+#else
 static struct itimerval itv;
+#endif
 
 /**
  * returns ticks for give timespec
@@ -69,6 +100,109 @@ static unsigned long ts2ticks(struct timespec *tp)
     return((tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
 }
 
+#ifdef MODULE_NATIVE_HRTIMER
+static uint64_t _now_ns(void)
+{
+    struct timespec t;
+
+    _native_syscall_enter();
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "timer: clock_gettime");
+    }
+    _native_syscall_leave();
+
+#ifdef MODULE_NATIVE_VTIME
+    return ((uint64_t)t.tv_sec * NS_PER_SEC) + t.tv_nsec +
+           (_vtime_offset * NS_PER_US);
+#else
+    return ((uint64_t)t.tv_sec * NS_PER_SEC) + t.tv_nsec;
+#endif
+}
+
+static void _arm(int channel, uint64_t deadline)
+{
+    struct itimerspec its;
+#ifdef MODULE_NATIVE_VTIME
+    /* the host timer runs on the host clock */
+    uint64_t host = deadline ? deadline - (_vtime_offset * NS_PER_US) : 0;
+#else
+    uint64_t host = deadline;
+#endif
+
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = host / NS_PER_SEC;
+    its.it_value.tv_nsec = host % NS_PER_SEC;
+
+    /* set before arming, so a signal in between finds the deadline */
+    _channels[channel].deadline = deadline;
+
+    _native_syscall_enter();
+    if (timer_settime(_channels[channel].timer, deadline ? TIMER_ABSTIME : 0,
+                      &its, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: timer_settime");
+    }
+    _native_syscall_leave();
+}
+
+void native_timer_jitter(native_timer_jitter_t *jitter, bool reset)
+{
+    unsigned state = irq_disable();
+
+    *jitter = _jitter;
+    if (reset) {
+        memset(&_jitter, 0, sizeof(_jitter));
+    }
+
+    irq_restore(state);
+}
+
+#ifdef MODULE_NATIVE_VTIME
+bool native_vtime_advance(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    if (_native_sigpend > 0) {
+        /* interrupts pending, they may set an earlier deadline */
+        return true;
+    }
+
+    for (unsigned i = 0; i < TIMER_0_CHANNELS; i++) {
+        if (_channels[i].deadline && (_channels[i].deadline < next)) {
+            next = _channels[i].deadline;
+        }
+    }
+    if (next == UINT64_MAX) {
+        return false;
+    }
+
+    uint64_t now = _now_ns();
+    if (next > now) {
+        _vtime_offset += (next - now + NS_PER_US - 1) / NS_PER_US;
+        DEBUG("native_vtime_advance: +%lu us\n",
+              (unsigned long)((next - now) / NS_PER_US));
+
+        /* the host timers still expire at the old host time of their
+         * deadline, move them along with the virtual clock */
+        for (unsigned i = 0; i < TIMER_0_CHANNELS; i++) {
+            if (_channels[i].deadline) {
+                _arm(i, _channels[i].deadline);
+            }
+        }
+    }
+
+    /* raise the timer interrupt as if the host timer had fired, the host
+     * timers of expired channels fire as well and find nothing to do */
+    int sig = SIGALRM;
+    if (real_write(_sig_pipefd[1], &sig, sizeof(sig)) == -1) {
+        err(EXIT_FAILURE, "native_vtime_advance: real_write");
+    }
+    _native_sigpend++;
+
+    return true;
+}
+#endif
+#endif
+
 /**
  * native timer signal handler
  *
@@ -78,7 +212,30 @@ void native_isr_timer(void)
 {
     DEBUG("%s\n", __func__);
 
+#ifdef MODULE_NATIVE_HRTIMER
+    /* SIGALRM does not queue, so one signal may stand for several channels */
+    uint64_t now = _now_ns();
+
+    for (int i = 0; i < (int)TIMER_0_CHANNELS; i++) {
+        uint64_t deadline = _channels[i].deadline;
+
+        if ((deadline == 0) || (deadline > now)) {
+            continue;
+        }
+        _channels[i].deadline = 0;
+
+        uint32_t late = (uint32_t)(now - deadline);
+        _jitter.count++;
+        _jitter.sum += late;
+        if (late > _jitter.max) {
+            _jitter.max = late;
+        }
+
+        _callback(_cb_arg, i);
+    }
+#else
     _callback(_cb_arg, 0);
+#endif
 }
 
 int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
@@ -98,6 +255,30 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
 
     _callback = cb;
     _cb_arg = arg;
+
+#ifdef MODULE_NATIVE_HRTIMER
+    for (unsigned i = 0; i < TIMER_0_CHANNELS; i++) {
+        if (_timers_created) {
+            /* re-initialized, keep the host timers */
+            _arm(i, 0);
+            continue;
+        }
+
+        struct sigevent sev;
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = SIGALRM;
+
+        _native_syscall_enter();
+        if (timer_create(CLOCK_MONOTONIC, &sev, &_channels[i].timer) == -1) {
+            err(EXIT_FAILURE, "timer_init: timer_create");
+        }
+        _native_syscall_leave();
+    }
+    _timers_created = true;
+    memset(&_jitter, 0, sizeof(_jitter));
+#endif
+
     if (register_interrupt(SIGALRM, native_isr_timer) != 0) {
         DEBUG("darn!\n\n");
     }
@@ -105,6 +286,54 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
     return 0;
 }
 
+#ifdef MODULE_NATIVE_HRTIMER
+int timer_set(tim_t dev, int channel, unsigned int offset)
+{
+    DEBUG("%s\n", __func__);
+
+    if ((dev >= TIMER_NUMOF) || (channel < 0) ||
+        (channel >= (int)TIMER_0_CHANNELS)) {
+        return -1;
+    }
+
+    /* a deadline in the past fires right away */
+    _arm(channel, _now_ns() + ((uint64_t)offset * NS_PER_US));
+
+    return 1;
+}
+
+int timer_set_absolute(tim_t dev, int channel, unsigned int value)
+{
+    DEBUG("%s\n", __func__);
+
+    if ((dev >= TIMER_NUMOF) || (channel < 0) ||
+        (channel >= (int)TIMER_0_CHANNELS)) {
+        return -1;
+    }
+
+    /* the deadline is derived from the same clock reading as the tick count,
+     * so setting the same value twice yields the same deadline */
+    uint64_t now = _now_ns();
+    uint64_t now_us = now / NS_PER_US;
+    uint32_t ticks = (uint32_t)(now_us - time_null);
+
+    _arm(channel, (now_us + (uint32_t)(value - ticks)) * NS_PER_US);
+
+    return 1;
+}
+
+int timer_clear(tim_t dev, int channel)
+{
+    if ((dev >= TIMER_NUMOF) || (channel < 0) ||
+        (channel >= (int)TIMER_0_CHANNELS)) {
+        return -1;
+    }
+
+    _arm(channel, 0);
+
+    return 1;
+}
+#else
 static void do_timer_set(unsigned int offset)
 {
     DEBUG("%s\n", __func__);
@@ -159,6 +388,7 @@ int timer_clear(tim_t dev, int channel)
 
     return 1;
 }
+#endif
 
 void timer_start(tim_t dev)
 {
@@ -200,5 +430,9 @@ unsigned int timer_read(tim_t dev)
 #endif
     _native_syscall_leave();
 
+#ifdef MODULE_NATIVE_VTIME
+    return ts2ticks(&t) + _vtime_offset - time_null;
+#else
     return ts2ticks(&t) - time_null;
+#endif
 }
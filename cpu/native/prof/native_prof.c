@@ -0,0 +1,580 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Thread-aware sampling profiler for native
+ *
+ * @}
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <err.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#ifndef __MACH__
+#include <elf.h>
+#endif
+
+#include "irq.h"
+#include "native_internal.h"
+#include "native_prof.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _PATH_DEFAULT       "/tmp/riot.prof.%d.folded"
+#define _OUT_BUF_SIZE       (512U)
+
+#ifndef __MACH__
+#if UINTPTR_MAX == UINT32_MAX
+typedef Elf32_Ehdr _elf_ehdr_t;
+typedef Elf32_Shdr _elf_shdr_t;
+typedef Elf32_Sym _elf_sym_t;
+#define _ELF_ST_TYPE(info)  ELF32_ST_TYPE(info)
+#else
+typedef Elf64_Ehdr _elf_ehdr_t;
+typedef Elf64_Shdr _elf_shdr_t;
+typedef Elf64_Sym _elf_sym_t;
+#define _ELF_ST_TYPE(info)  ELF64_ST_TYPE(info)
+#endif
+#endif
+
+/**
+ * @brief   One distinct call stack and the number of samples that hit it
+ */
+typedef struct {
+    uint32_t count;                 /**< number of samples, 0 if unused */
+    const char *thread;             /**< thread label, NULL to use pid */
+    kernel_pid_t pid;               /**< sampled thread */
+    uint8_t depth;                  /**< number of frames in pc */
+    uintptr_t pc[NATIVE_PROF_DEPTH];/**< frames, sampled function first */
+    uintptr_t top;                  /**< word on top of the stack */
+} _stack_t;
+
+/**
+ * @brief   Function symbol of the executable
+ */
+typedef struct {
+    uintptr_t addr;
+    uintptr_t size;
+    const char *name;
+} _sym_t;
+
+/**
+ * @brief   Buffered output for the folded stacks
+ */
+typedef struct {
+    int fd;
+    size_t len;
+    int res;
+    char buf[_OUT_BUF_SIZE];
+} _out_t;
+
+static _stack_t _stacks[NATIVE_PROF_SLOTS];
+static uint32_t _dropped;
+static const char *_path;
+static char _path_default[sizeof(_PATH_DEFAULT) + 8];
+
+static _sym_t *_syms;
+static size_t _syms_numof;
+static void *_exe_base;
+
+static void _timer_set(unsigned hz, struct itimerval *old)
+{
+    struct itimerval it = { .it_interval = { .tv_usec = 0 } };
+
+    if (hz > 0) {
+        it.it_interval.tv_usec = 1000000U / hz;
+        it.it_value = it.it_interval;
+    }
+    if (real_setitimer(ITIMER_PROF, &it, old) == -1) {
+        err(EXIT_FAILURE, "native_prof: setitimer");
+    }
+}
+
+static void _timer_restore(const struct itimerval *old)
+{
+    if (real_setitimer(ITIMER_PROF, old, NULL) == -1) {
+        err(EXIT_FAILURE, "native_prof: setitimer");
+    }
+}
+
+#if defined(__linux__) && defined(__i386__)
+#define _REG_PC             REG_EIP
+#define _REG_SP             REG_ESP
+#define _REG_FP             REG_EBP
+#elif defined(__linux__) && defined(__x86_64__)
+#define _REG_PC             REG_RIP
+#define _REG_SP             REG_RSP
+#define _REG_FP             REG_RBP
+#endif
+
+#ifdef _REG_FP
+/**
+ * @brief   Get the end of the stack @p sp points into
+ *
+ * Frames are only followed within [sp, end), so a broken frame pointer
+ * chain never leads outside of the stack of the sampled context.
+ */
+static uintptr_t _stack_end(uintptr_t sp)
+{
+    uintptr_t isr = (uintptr_t)__isr_stack;
+
+    if ((sp >= isr) && (sp < isr + sizeof(__isr_stack))) {
+        return isr + sizeof(__isr_stack);
+    }
+    /* thread_create() places the thread control block right above the
+     * stack */
+    if ((sched_active_thread != NULL) && (sp < (uintptr_t)sched_active_thread)) {
+        return (uintptr_t)sched_active_thread;
+    }
+    return sp;
+}
+#endif
+
+/**
+ * @brief   Walk the call stack of the interrupted context
+ *
+ * Leaf functions may be compiled without a frame, in which case the chain
+ * starts at the caller's frame and the caller itself is missing.  The word on
+ * top of the stack is returned in @p top so _leaf_caller() can recover it.
+ */
+static unsigned _backtrace(ucontext_t *ctx, uintptr_t *pc, uintptr_t *top)
+{
+    unsigned depth = 0;
+
+    *top = 0;
+
+#ifdef __MACH__
+    pc[depth++] = ctx->uc_mcontext->__ss.__eip;
+#elif defined(__FreeBSD__)
+    pc[depth++] = ((struct sigcontext *)ctx)->sc_eip;
+#elif defined(__arm__)
+    pc[depth++] = ctx->uc_mcontext.arm_pc;
+#else /* Linux/x86 */
+    uintptr_t sp = ctx->uc_mcontext.gregs[_REG_SP];
+    uintptr_t fp = ctx->uc_mcontext.gregs[_REG_FP];
+    uintptr_t end = _stack_end(sp);
+
+    pc[depth++] = ctx->uc_mcontext.gregs[_REG_PC];
+    if (sp + sizeof(uintptr_t) <= end) {
+        *top = *(const uintptr_t *)sp;
+    }
+    while ((depth < NATIVE_PROF_DEPTH) && (fp >= sp)
+           && ((fp % sizeof(uintptr_t)) == 0)
+           && ((fp + 2 * sizeof(uintptr_t)) <= end)) {
+        const uintptr_t *frame = (const uintptr_t *)fp;
+
+        if (frame[1] == 0) {
+            break;
+        }
+        pc[depth++] = frame[1];
+        if (frame[0] <= fp) {
+            break;
+        }
+        fp = frame[0];
+    }
+#endif
+    return depth;
+}
+
+static void _record(const char *thread, kernel_pid_t pid,
+                    const uintptr_t *pc, unsigned depth, uintptr_t top)
+{
+    /* FNV-1a over the stack identity */
+    uint32_t hash = 2166136261U;
+
+    hash = (hash ^ (uint32_t)pid) * 16777619U;
+    hash = (hash ^ (uint32_t)(uintptr_t)thread) * 16777619U;
+    for (unsigned i = 0; i < depth; i++) {
+        hash = (hash ^ (uint32_t)pc[i]) * 16777619U;
+    }
+    hash = (hash ^ (uint32_t)top) * 16777619U;
+
+    for (unsigned n = 0; n < NATIVE_PROF_SLOTS; n++) {
+        _stack_t *s = &_stacks[(hash + n) % NATIVE_PROF_SLOTS];
+
+        if (s->count == 0) {
+            s->thread = thread;
+            s->pid = pid;
+            s->depth = depth;
+            memcpy(s->pc, pc, depth * sizeof(pc[0]));
+            s->top = top;
+            s->count = 1;
+            return;
+        }
+        if ((s->pid == pid) && (s->thread == thread) && (s->depth == depth)
+            && (s->top == top) && (memcmp(s->pc, pc, depth * sizeof(pc[0])) == 0)) {
+            s->count++;
+            return;
+        }
+    }
+    _dropped++;
+}
+
+void native_prof_sample(int sig, siginfo_t *info, void *context)
+{
+    (void)sig;
+    (void)info;
+
+    uintptr_t pc[NATIVE_PROF_DEPTH];
+    uintptr_t top;
+    unsigned depth = _backtrace((ucontext_t *)context, pc, &top);
+    const char *thread = NULL;
+    kernel_pid_t pid = KERNEL_PID_UNDEF;
+
+    if (_native_in_isr) {
+        thread = "isr";
+    }
+    else if (sched_active_thread == NULL) {
+        thread = "native";
+    }
+    else {
+        pid = sched_active_pid;
+#ifdef DEVELHELP
+        thread = sched_active_thread->name;
+#endif
+    }
+    _record(thread, pid, pc, depth, top);
+}
+
+static int _sym_cmp(const void *a, const void *b)
+{
+    const _sym_t *sa = a;
+    const _sym_t *sb = b;
+
+    return (sa->addr > sb->addr) - (sa->addr < sb->addr);
+}
+
+/**
+ * @brief   Read the function symbols from the executable's symbol table
+ *
+ * dladdr() only knows about exported symbols, which an executable has none
+ * of, so the ELF file is mapped and parsed instead.
+ */
+static void _syms_load(void)
+{
+#ifndef __MACH__
+#ifdef __linux__
+    const char *exe = "/proc/self/exe";
+#else
+    const char *exe = _progname;
+#endif
+    struct stat st;
+    int fd = real_open(exe, O_RDONLY);
+
+    if (fd == -1) {
+        return;
+    }
+    if ((fstat(fd, &st) == -1) || ((size_t)st.st_size < sizeof(_elf_ehdr_t))) {
+        real_close(fd);
+        return;
+    }
+
+    const uint8_t *image = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    size_t size = st.st_size;
+
+    real_close(fd);
+    if (image == MAP_FAILED) {
+        return;
+    }
+
+    /* the image stays mapped, symbol names point into it */
+    const _elf_ehdr_t *eh = (const _elf_ehdr_t *)image;
+    if ((memcmp(eh->e_ident, ELFMAG, SELFMAG) != 0) || (eh->e_shoff == 0)
+        || (eh->e_shoff + eh->e_shnum * sizeof(_elf_shdr_t) > size)) {
+        return;
+    }
+
+    Dl_info info;
+    if (dladdr(&_syms, &info) == 0) {
+        return;
+    }
+    _exe_base = info.dli_fbase;
+
+    uintptr_t bias = 0;
+    if (eh->e_type == ET_DYN) {
+        /* position independent executable: symbols are relative to the
+         * load address */
+        bias = (uintptr_t)_exe_base;
+    }
+
+    const _elf_shdr_t *sh = (const _elf_shdr_t *)(image + eh->e_shoff);
+    for (unsigned i = 0; i < eh->e_shnum; i++) {
+        if ((sh[i].sh_type != SHT_SYMTAB) || (sh[i].sh_link >= eh->e_shnum)) {
+            continue;
+        }
+
+        const _elf_shdr_t *strtab = &sh[sh[i].sh_link];
+        if ((sh[i].sh_offset + sh[i].sh_size > size)
+            || (strtab->sh_offset + strtab->sh_size > size)) {
+            return;
+        }
+
+        const _elf_sym_t *sym = (const _elf_sym_t *)(image + sh[i].sh_offset);
+        size_t numof = sh[i].sh_size / sizeof(_elf_sym_t);
+
+        _syms = real_malloc(numof * sizeof(_sym_t));
+        if (_syms == NULL) {
+            return;
+        }
+        for (size_t n = 0; n < numof; n++) {
+            if ((_ELF_ST_TYPE(sym[n].st_info) != STT_FUNC)
+                || (sym[n].st_value == 0)
+                || (sym[n].st_name >= strtab->sh_size)) {
+                continue;
+            }
+            _syms[_syms_numof].addr = sym[n].st_value + bias;
+            _syms[_syms_numof].size = sym[n].st_size;
+            _syms[_syms_numof].name = (const char *)image + strtab->sh_offset
+                                      + sym[n].st_name;
+            _syms_numof++;
+        }
+        qsort(_syms, _syms_numof, sizeof(_sym_t), _sym_cmp);
+        DEBUG("native_prof: %u function symbols\n", (unsigned)_syms_numof);
+        return;
+    }
+#endif
+}
+
+/**
+ * @brief   Find the function of the executable that contains @p pc
+ */
+static const _sym_t *_sym_find(uintptr_t pc)
+{
+    size_t lo = 0, hi = _syms_numof;
+
+    /* find the last symbol starting at or below pc */
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (_syms[mid].addr <= pc) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    if (lo > 0) {
+        const _sym_t *sym = &_syms[lo - 1];
+
+        /* assembly functions may come without a size */
+        if ((pc < sym->addr + sym->size)
+            || ((sym->size == 0) && (lo < _syms_numof))) {
+            return sym;
+        }
+    }
+    return NULL;
+}
+
+static const char *_sym_name(uintptr_t pc, char *buf, size_t len)
+{
+    Dl_info info;
+
+    if ((dladdr((void *)pc, &info) != 0) && (info.dli_fbase != _exe_base)) {
+        /* shared libraries export their symbols */
+        if (info.dli_sname != NULL) {
+            return info.dli_sname;
+        }
+        if (info.dli_fname != NULL) {
+            const char *lib = strrchr(info.dli_fname, '/');
+
+            snprintf(buf, len, "[%s]", (lib != NULL) ? lib + 1 : info.dli_fname);
+            return buf;
+        }
+    }
+    else {
+        const _sym_t *sym = _sym_find(pc);
+
+        if (sym != NULL) {
+            return sym->name;
+        }
+    }
+
+    snprintf(buf, len, "0x%" PRIxPTR, pc);
+    return buf;
+}
+
+/**
+ * @brief   Get the caller of a sampled function that has no frame
+ *
+ * If the function has no frame, the word on top of the stack is the return
+ * address behind the call to it.  This is only accepted if the instruction
+ * before it is a direct call of exactly that function.
+ *
+ * @return  return address into the caller, 0 if not applicable
+ */
+static uintptr_t _leaf_caller(const _stack_t *s)
+{
+#ifdef _REG_FP
+    const _sym_t *leaf = _sym_find(s->pc[0]);
+    int32_t rel;
+
+    /* e8 <rel32>: call relative to the next instruction */
+    if ((leaf == NULL) || (s->top < 5) || (_sym_find(s->top - 5) == NULL)
+        || (*(const uint8_t *)(s->top - 5) != 0xe8)) {
+        return 0;
+    }
+    memcpy(&rel, (const void *)(s->top - 4), sizeof(rel));
+    return (s->top + rel == leaf->addr) ? s->top : 0;
+#else
+    (void)s;
+    return 0;
+#endif
+}
+
+static void _out_flush(_out_t *out)
+{
+    size_t pos = 0;
+
+    while ((out->res == 0) && (pos < out->len)) {
+        ssize_t res = real_write(out->fd, out->buf + pos, out->len - pos);
+
+        if (res < 0) {
+            out->res = -errno;
+        }
+        else {
+            pos += res;
+        }
+    }
+    out->len = 0;
+}
+
+static void _out_str(_out_t *out, const char *str)
+{
+    while (*str != '\0') {
+        if (out->len == sizeof(out->buf)) {
+            _out_flush(out);
+        }
+        out->buf[out->len++] = *str++;
+    }
+}
+
+int native_prof_dump(const char *path)
+{
+    struct itimerval timer;
+    _out_t out = { .fd = STDOUT_FILENO };
+    char buf[64];
+
+    _timer_set(0, &timer);
+    _native_syscall_enter();
+
+    if (path != NULL) {
+        out.fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out.fd == -1) {
+            out.res = -errno;
+            goto out;
+        }
+    }
+    if (_syms == NULL) {
+        _syms_load();
+    }
+
+    for (unsigned i = 0; i < NATIVE_PROF_SLOTS; i++) {
+        const _stack_t *s = &_stacks[i];
+
+        if (s->count == 0) {
+            continue;
+        }
+        if (s->thread != NULL) {
+            _out_str(&out, s->thread);
+        }
+        else {
+            snprintf(buf, sizeof(buf), "pid%d", (int)s->pid);
+            _out_str(&out, buf);
+        }
+        /* return addresses point behind the call, which may already be
+         * the next function */
+        for (unsigned n = s->depth; n > 1; n--) {
+            _out_str(&out, ";");
+            _out_str(&out, _sym_name(s->pc[n - 1] - 1, buf, sizeof(buf)));
+        }
+        uintptr_t caller = _leaf_caller(s);
+        if (caller != 0) {
+            _out_str(&out, ";");
+            _out_str(&out, _sym_name(caller - 1, buf, sizeof(buf)));
+        }
+        _out_str(&out, ";");
+        _out_str(&out, _sym_name(s->pc[0], buf, sizeof(buf)));
+        snprintf(buf, sizeof(buf), " %" PRIu32 "\n", s->count);
+        _out_str(&out, buf);
+    }
+    if (_dropped > 0) {
+        snprintf(buf, sizeof(buf), "[dropped] %" PRIu32 "\n", _dropped);
+        _out_str(&out, buf);
+    }
+    _out_flush(&out);
+
+    if (path != NULL) {
+        real_close(out.fd);
+    }
+
+out:
+    _native_syscall_leave();
+    _timer_restore(&timer);
+    return out.res;
+}
+
+void native_prof_reset(void)
+{
+    struct itimerval timer;
+
+    _timer_set(0, &timer);
+    memset(_stacks, 0, sizeof(_stacks));
+    _dropped = 0;
+    _timer_restore(&timer);
+}
+
+static void _at_exit(void)
+{
+    int res;
+
+    _timer_set(0, NULL);
+    irq_disable();
+    res = native_prof_dump(_path);
+    if (res < 0) {
+        warnx("native_prof: writing %s: %s", _path, strerror(-res));
+    }
+    else {
+        real_printf("native_prof: profile written to %s\n", _path);
+    }
+}
+
+void native_prof_init(const char *path)
+{
+    if (path == NULL) {
+        snprintf(_path_default, sizeof(_path_default), _PATH_DEFAULT,
+                 (int)real_getpid());
+        path = _path_default;
+    }
+    _path = path;
+
+    if (atexit(_at_exit) != 0) {
+        err(EXIT_FAILURE, "native_prof_init: atexit");
+    }
+    _timer_set(NATIVE_PROF_HZ, NULL);
+}
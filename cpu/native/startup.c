@@ -67,6 +67,11 @@ const char *_native_unix_socket_path = NULL;
 
 netdev_tap_params_t netdev_tap_params[NETDEV_TAP_MAX];
 #endif
+#ifdef MODULE_NETDEV_VRADIO
+#include "netdev_vradio.h"
+
+netdev_vradio_params_t netdev_vradio_params[NETDEV_VRADIO_MAX];
+#endif
 #ifdef MODULE_MTD_NATIVE
 #include "board.h"
 #include "mtd_native.h"
@@ -81,6 +86,12 @@ static const char short_opts[] = ":hi:s:deEoc:"
 #endif
 #ifdef MODULE_CAN_LINUX
     "n:"
+#endif
+#ifdef MODULE_NETDEV_VRADIO
+    "r:"
+#endif
+#ifdef MODULE_NATIVE_PROF
+    "P:"
 #endif
     "";
 
@@ -98,6 +109,12 @@ static const struct option long_opts[] = {
 #endif
 #ifdef MODULE_CAN_LINUX
     { "can", required_argument, NULL, 'n' },
+#endif
+#ifdef MODULE_NETDEV_VRADIO
+    { "vradio", required_argument, NULL, 'r' },
+#endif
+#ifdef MODULE_NATIVE_PROF
+    { "profile", required_argument, NULL, 'P' },
 #endif
     { NULL, 0, NULL, '\0' },
 };
@@ -228,6 +245,11 @@ void usage_exit(int status)
         real_printf(" <tap interface %d>", i + 1);
     }
 #endif
+#if defined(MODULE_NETDEV_VRADIO)
+    for (int i = 0; i < NETDEV_VRADIO_MAX; i++) {
+        real_printf(" -r <node>[:<medium>]");
+    }
+#endif
 
     real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty>]\n");
 
@@ -264,6 +286,19 @@ void usage_exit(int status)
 "    -n <ifnum>:<ifname>, --can <ifnum>:<ifname>\n"
 "        specify CAN interface <ifname> to use for CAN device #<ifnum>\n"
 "        max number of CAN device: %d\n", CAN_DLL_NUMOF);
+#endif
+#ifdef MODULE_NETDEV_VRADIO
+    real_printf(
+"    -r <node>[:<medium>], --vradio=<node>[:<medium>]\n"
+"        attach the next virtual radio as <node> to the medium served by\n"
+"        vradiod (default medium: %s). Required once per radio (%d)\n",
+        VRADIO_MEDIUM_DEFAULT, NETDEV_VRADIO_MAX);
+#endif
+#ifdef MODULE_NATIVE_PROF
+    real_printf(
+"    -P <file>, --profile=<file>\n"
+"        write the sampled folded stacks to <file> on exit\n"
+"        (default: /tmp/riot.prof.PID.folded)\n");
 #endif
     real_exit(status);
 }
@@ -295,6 +330,12 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
     _native_id = _native_pid;
 
     int c, opt_idx = 0, uart = 0;
+#ifdef MODULE_NETDEV_VRADIO
+    int vradio = 0;
+#endif
+#ifdef MODULE_NATIVE_PROF
+    const char *prof_path = NULL;
+#endif
     bool dmn = false, force_stderr = false;
     _stdiotype_t stderrtype = _STDIOTYPE_STDIO;
     _stdiotype_t stdouttype = _STDIOTYPE_STDIO;
@@ -360,6 +401,24 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
                         CAN_MAX_SIZE_INTERFACE_NAME);
                 }
                 break;
+#endif
+#ifdef MODULE_NETDEV_VRADIO
+            case 'r': {
+                char *medium = strchr(optarg, ':');
+                if (vradio >= NETDEV_VRADIO_MAX) {
+                    usage_exit(EXIT_FAILURE);
+                }
+                netdev_vradio_params[vradio].node = atol(optarg);
+                netdev_vradio_params[vradio].medium =
+                    (medium != NULL) ? medium + 1 : VRADIO_MEDIUM_DEFAULT;
+                vradio++;
+                }
+                break;
+#endif
+#ifdef MODULE_NATIVE_PROF
+            case 'P':
+                prof_path = optarg;
+                break;
 #endif
             default:
                 usage_exit(EXIT_FAILURE);
@@ -374,6 +433,12 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
         }
     }
 #endif
+#ifdef MODULE_NETDEV_VRADIO
+    if (vradio < NETDEV_VRADIO_MAX) {
+        /* no node given for a radio */
+        usage_exit(EXIT_FAILURE);
+    }
+#endif
 
     if (dmn) {
         filter_daemonize_argv(_native_argv);
@@ -431,6 +496,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
 
     native_cpu_init();
     native_interrupt_init();
+#ifdef MODULE_NATIVE_PROF
+    native_prof_init(prof_path);
+#endif
 #ifdef MODULE_NETDEV_TAP
     for (int i = 0; i < NETDEV_TAP_MAX; i++) {
         netdev_tap_params[i].tap_name = &argv[optind + i];
@@ -36,7 +36,7 @@
 #endif
 
 #ifndef NRFMIN_GNRC_STACKSIZE
-#define NRFMIN_GNRC_STACKSIZE       THREAD_STACKSIZE_DEFAULT
+#define NRFMIN_GNRC_STACKSIZE       (THREAD_STACKSIZE_DEFAULT + GNRC_NETIF_EXTRA_STACKSIZE)
 #endif
 /** @} */
 
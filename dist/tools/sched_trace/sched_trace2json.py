@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Convert a RIOT scheduler trace dump into a Chrome trace JSON file.
+
+The input is the console output of the `trace dump` shell command (or of
+sched_trace_dump()); unrelated lines are ignored.  The output can be loaded
+into chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+EV_SWITCH = 0
+EV_IRQ_ENTER = 1
+EV_IRQ_EXIT = 2
+EV_MSG_SEND = 3
+EV_MSG_RECEIVE = 4
+EV_MUTEX_BLOCK = 5
+EV_MUTEX_UNBLOCK = 6
+
+RE_START = re.compile(r"trace: start hz=(\d+) records=(\d+) lost=(\d+)")
+RE_THREAD = re.compile(r"trace: thread (\d+) (\S+)")
+RE_RECORD = re.compile(r"trace: ([0-9a-fA-F]{8}) (\d+) (\d+) (\d+)")
+RE_END = re.compile(r"trace: end")
+
+TRACE_PID = 0
+IRQ_TID = 1000
+
+
+def parse(lines):
+    """Return (hz, threads, records) of the last complete dump in lines."""
+    dump = None
+    result = None
+    for line in lines:
+        match = RE_START.search(line)
+        if match:
+            dump = (int(match.group(1)), {}, [])
+            continue
+        if dump is None:
+            continue
+        match = RE_THREAD.search(line)
+        if match:
+            dump[1][int(match.group(1))] = match.group(2)
+            continue
+        match = RE_RECORD.search(line)
+        if match:
+            dump[2].append((int(match.group(1), 16), int(match.group(2)),
+                            int(match.group(3)), int(match.group(4))))
+            continue
+        if RE_END.search(line):
+            result = dump
+            dump = None
+    if result is None:
+        sys.exit("error: no complete trace dump found")
+    return result
+
+
+def unwrap(records):
+    """Turn 32 bit wrapping timestamps into monotonic ones starting at 0."""
+    offset = 0
+    first = records[0][0] if records else 0
+    last = None
+    for time, event, pid, arg in records:
+        if last is not None and time < last:
+            offset += 1 << 32
+        last = time
+        yield time + offset - first, event, pid, arg
+
+
+def convert(hz, threads, records):
+    events = []
+
+    def thread_name(pid):
+        return threads.get(pid, "pid{}".format(pid))
+
+    def ts(ticks):
+        return ticks * 1000000.0 / hz
+
+    for pid in sorted(threads):
+        events.append({"ph": "M", "name": "thread_name", "pid": TRACE_PID,
+                       "tid": pid, "args": {"name": thread_name(pid)}})
+    events.append({"ph": "M", "name": "thread_name", "pid": TRACE_PID,
+                   "tid": IRQ_TID, "args": {"name": "interrupts"}})
+
+    running = None
+    run_start = None
+    time = 0
+    for time, event, pid, arg in unwrap(records):
+        if event == EV_SWITCH:
+            if running is not None:
+                events.append({"ph": "X", "name": "running",
+                               "pid": TRACE_PID, "tid": running,
+                               "ts": ts(run_start),
+                               "dur": ts(time) - ts(run_start)})
+            running = pid
+            run_start = time
+        elif event in (EV_IRQ_ENTER, EV_IRQ_EXIT):
+            events.append({"ph": "B" if event == EV_IRQ_ENTER else "E",
+                           "name": "irq {}".format(arg),
+                           "pid": TRACE_PID, "tid": IRQ_TID, "ts": ts(time)})
+        elif event == EV_MSG_SEND:
+            events.append({"ph": "i", "s": "t",
+                           "name": "msg send to {}".format(thread_name(pid)),
+                           "pid": TRACE_PID,
+                           "tid": running if running is not None else pid,
+                           "ts": ts(time), "args": {"type": arg}})
+        elif event == EV_MSG_RECEIVE:
+            events.append({"ph": "i", "s": "t", "name": "msg receive",
+                           "pid": TRACE_PID, "tid": pid, "ts": ts(time),
+                           "args": {"type": arg}})
+        elif event in (EV_MUTEX_BLOCK, EV_MUTEX_UNBLOCK):
+            name = "mutex block" if event == EV_MUTEX_BLOCK else "mutex unblock"
+            events.append({"ph": "i", "s": "t", "name": name,
+                           "pid": TRACE_PID, "tid": pid, "ts": ts(time),
+                           "args": {"mutex": "0x{:04x}".format(arg)}})
+
+    if running is not None:
+        events.append({"ph": "X", "name": "running", "pid": TRACE_PID,
+                       "tid": running, "ts": ts(run_start),
+                       "dur": ts(time) - ts(run_start)})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="console log containing a trace dump")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout, help="JSON output file")
+    args = parser.parse_args()
+
+    hz, threads, records = parse(args.input)
+    json.dump(convert(hz, threads, records), args.output, indent=1)
+    args.output.write("\n")
+
+
+if __name__ == "__main__":
+    main()
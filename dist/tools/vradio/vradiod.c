@@ -0,0 +1,541 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/*
+ * Virtual IEEE 802.15.4 radio medium for native instances using the
+ * netdev_vradio driver, see README.md.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "vradio_medium.h"
+
+/* deliveries in flight at once */
+#define QUEUE_SIZE          (4096U)
+/* O-QPSK at 250 kbit/s: preamble, SFD, PHR and FCS on top of the frame */
+#define US_PER_BYTE         (32U)
+#define PHY_OVERHEAD        (8U)
+#define RSSI_MIN            (-100)
+#define RSSI_MAX            (-20)
+
+typedef struct {
+    bool up;
+    double loss;
+    uint32_t latency;
+    int8_t rssi;
+} link_t;
+
+typedef struct {
+    uint64_t due;
+    uint64_t seq;
+    unsigned dst;
+    vradio_frame_t frame;
+} delivery_t;
+
+typedef struct {
+    unsigned long tx;
+    unsigned long rx;
+    unsigned long lost;
+    unsigned long missed;
+    unsigned long overflow;
+} stats_t;
+
+static const char *_name = VRADIO_MEDIUM_DEFAULT;
+static unsigned _numof = 16;
+static bool _airtime = true;
+static bool _verbose = false;
+static link_t _default = { .up = true, .loss = 0.0, .latency = 0, .rssi = -60 };
+
+static vradio_medium_t *_medium;
+static int _sock = -1;
+static link_t _links[VRADIO_MEDIUM_NODES_MAX][VRADIO_MEDIUM_NODES_MAX];
+static uint64_t _tx_busy[VRADIO_MEDIUM_NODES_MAX];
+static bool _kick[VRADIO_MEDIUM_NODES_MAX];
+static stats_t _stats[VRADIO_MEDIUM_NODES_MAX];
+static delivery_t _queue[QUEUE_SIZE];
+static unsigned _queued;
+static unsigned long _queue_overflow;
+static uint64_t _seq;
+
+static volatile sig_atomic_t _stop;
+static volatile sig_atomic_t _dump;
+
+static void _usage(const char *prog)
+{
+    fprintf(stderr,
+"usage: %s [-m <medium>] [-n <nodes>] [-g mesh|line|grid:<width>]\n"
+"       [-t <topology file>] [-l <loss>] [-d <latency us>] [-r <rssi>]\n"
+"       [-s <seed>] [-A] [-v]\n"
+"\n"
+"    -m  name of the medium (default %s)\n"
+"    -n  number of nodes (default %u, max. %u)\n"
+"    -g  generated topology (default mesh)\n"
+"    -t  topology file, replaces the generated topology\n"
+"    -l  default loss probability of a link, 0.0 to 1.0\n"
+"    -d  default latency of a link in microseconds\n"
+"    -r  default RSSI of a link in dBm\n"
+"    -s  seed of the loss decisions\n"
+"    -A  deliver frames without simulating their air time\n"
+"    -v  print every frame\n",
+            prog, VRADIO_MEDIUM_DEFAULT, _numof, VRADIO_MEDIUM_NODES_MAX);
+    exit(EXIT_FAILURE);
+}
+
+static uint64_t _now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+static void _link(unsigned a, unsigned b, const link_t *link, bool both)
+{
+    _links[a][b] = *link;
+    if (both) {
+        _links[b][a] = *link;
+    }
+}
+
+static void _generate(const char *topo)
+{
+    unsigned width;
+
+    if (strcmp(topo, "mesh") == 0) {
+        for (unsigned a = 0; a < _numof; a++) {
+            for (unsigned b = 0; b < _numof; b++) {
+                if (a != b) {
+                    _link(a, b, &_default, false);
+                }
+            }
+        }
+    }
+    else if (strcmp(topo, "line") == 0) {
+        for (unsigned a = 1; a < _numof; a++) {
+            _link(a - 1, a, &_default, true);
+        }
+    }
+    else if ((sscanf(topo, "grid:%u", &width) == 1) && (width > 0)) {
+        for (unsigned a = 0; a < _numof; a++) {
+            if (((a % width) + 1 < width) && (a + 1 < _numof)) {
+                _link(a, a + 1, &_default, true);
+            }
+            if (a + width < _numof) {
+                _link(a, a + width, &_default, true);
+            }
+        }
+    }
+    else {
+        fprintf(stderr, "unknown topology %s\n", topo);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * one link per line:
+ *     <a> <b> [<loss> [<latency us> [<rssi>]]]    link in both directions
+ *     <a> > <b> [<loss> [<latency us> [<rssi>]]]  link from a to b only
+ * omitted values are taken from the command line defaults
+ */
+static void _load(const char *fname)
+{
+    char line[256];
+    unsigned lineno = 0;
+    FILE *f = fopen(fname, "r");
+
+    if (f == NULL) {
+        perror(fname);
+        exit(EXIT_FAILURE);
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        link_t link = _default;
+        unsigned a, b;
+        int rssi = link.rssi;
+        bool both = true;
+        int n;
+        char *p = line;
+
+        lineno++;
+        p += strspn(p, " \t");
+        if ((*p == '#') || (*p == '\n') || (*p == '\0')) {
+            continue;
+        }
+        if ((n = sscanf(p, "%u > %u %lf %u %d", &a, &b, &link.loss,
+                        &link.latency, &rssi)) >= 2) {
+            both = false;
+        }
+        else {
+            n = sscanf(p, "%u %u %lf %u %d", &a, &b, &link.loss,
+                       &link.latency, &rssi);
+        }
+        if ((n < 2) || (a >= _numof) || (b >= _numof) || (a == b) ||
+            (link.loss < 0.0) || (link.loss > 1.0)) {
+            fprintf(stderr, "%s:%u: invalid link\n", fname, lineno);
+            exit(EXIT_FAILURE);
+        }
+        link.rssi = (int8_t)rssi;
+        _link(a, b, &link, both);
+    }
+    fclose(f);
+}
+
+static void _create(void)
+{
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    struct sockaddr_un addr;
+    int fd;
+
+    snprintf(path, sizeof(path), VRADIO_SHM_FMT, _name);
+    shm_unlink(path);
+    if ((fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600)) == -1) {
+        perror("shm_open");
+        exit(EXIT_FAILURE);
+    }
+    if (ftruncate(fd, sizeof(vradio_medium_t)) == -1) {
+        perror("ftruncate");
+        exit(EXIT_FAILURE);
+    }
+    _medium = mmap(NULL, sizeof(vradio_medium_t), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+    close(fd);
+    if (_medium == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    memset(_medium, 0, sizeof(*_medium));
+    _medium->nodes_numof = _numof;
+    __atomic_store_n(&_medium->magic, VRADIO_MEDIUM_MAGIC, __ATOMIC_RELEASE);
+
+    if ((_sock = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0)) == -1) {
+        perror("socket");
+        exit(EXIT_FAILURE);
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), VRADIO_DAEMON_SOCK_FMT,
+             _name);
+    unlink(addr.sun_path);
+    if (bind(_sock, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        perror(addr.sun_path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void _destroy(void)
+{
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+
+    snprintf(path, sizeof(path), VRADIO_SHM_FMT, _name);
+    shm_unlink(path);
+    snprintf(path, sizeof(path), VRADIO_DAEMON_SOCK_FMT, _name);
+    unlink(path);
+}
+
+static bool _before(const delivery_t *a, const delivery_t *b)
+{
+    return (a->due < b->due) || ((a->due == b->due) && (a->seq < b->seq));
+}
+
+static void _swap(unsigned i, unsigned j)
+{
+    delivery_t tmp = _queue[i];
+
+    _queue[i] = _queue[j];
+    _queue[j] = tmp;
+}
+
+static void _push(uint64_t due, unsigned dst, const vradio_frame_t *frame)
+{
+    unsigned i = _queued;
+
+    if (_queued == QUEUE_SIZE) {
+        _queue_overflow++;
+        _stats[dst].overflow++;
+        return;
+    }
+    _queue[i].due = due;
+    _queue[i].seq = _seq++;
+    _queue[i].dst = dst;
+    _queue[i].frame = *frame;
+    _queued++;
+    while ((i > 0) && _before(&_queue[i], &_queue[(i - 1) / 2])) {
+        _swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void _pop(void)
+{
+    unsigned i = 0;
+
+    _queue[0] = _queue[--_queued];
+    for (;;) {
+        unsigned min = i;
+        unsigned l = (2 * i) + 1;
+        unsigned r = l + 1;
+
+        if ((l < _queued) && _before(&_queue[l], &_queue[min])) {
+            min = l;
+        }
+        if ((r < _queued) && _before(&_queue[r], &_queue[min])) {
+            min = r;
+        }
+        if (min == i) {
+            return;
+        }
+        _swap(i, min);
+        i = min;
+    }
+}
+
+static uint8_t _lqi(int rssi)
+{
+    if (rssi <= RSSI_MIN) {
+        return 0;
+    }
+    if (rssi >= RSSI_MAX) {
+        return 255;
+    }
+    return (uint8_t)(((rssi - RSSI_MIN) * 255) / (RSSI_MAX - RSSI_MIN));
+}
+
+/* take the frames sent by all nodes and schedule them at their neighbours */
+static void _collect(uint64_t now)
+{
+    for (unsigned src = 0; src < _numof; src++) {
+        vradio_ring_t *tx = &_medium->nodes[src].tx;
+        vradio_frame_t *frame;
+
+        while ((frame = vradio_ring_peek(tx)) != NULL) {
+            uint64_t start = (_tx_busy[src] > now) ? _tx_busy[src] : now;
+            uint64_t end = start;
+
+            /* a radio sends one frame after the other */
+            if (_airtime) {
+                end += (frame->len + PHY_OVERHEAD) * US_PER_BYTE;
+            }
+            _tx_busy[src] = end;
+            _stats[src].tx++;
+            if (_verbose) {
+                printf("%u: tx %u byte on channel %u\n", src,
+                       (unsigned)frame->len, (unsigned)frame->channel);
+            }
+
+            for (unsigned dst = 0; dst < _numof; dst++) {
+                const link_t *link = &_links[src][dst];
+
+                if (!link->up) {
+                    continue;
+                }
+                if ((link->loss > 0.0) && (drand48() < link->loss)) {
+                    _stats[dst].lost++;
+                    continue;
+                }
+                frame->rssi = link->rssi;
+                frame->lqi = _lqi(link->rssi);
+                _push(end + link->latency, dst, frame);
+            }
+            vradio_ring_pop(tx);
+        }
+    }
+}
+
+/* hand over the frames whose time has come */
+static void _deliver(uint64_t now)
+{
+    while ((_queued > 0) && (_queue[0].due <= now)) {
+        delivery_t *d = &_queue[0];
+        vradio_node_t *node = &_medium->nodes[d->dst];
+
+        if (!__atomic_load_n(&node->pid, __ATOMIC_ACQUIRE) ||
+            !__atomic_load_n(&node->rx_on, __ATOMIC_ACQUIRE) ||
+            (__atomic_load_n(&node->channel, __ATOMIC_ACQUIRE) !=
+             d->frame.channel)) {
+            /* radio off or tuned to another channel */
+            _stats[d->dst].missed++;
+        }
+        else if (vradio_ring_put(&node->rx, &d->frame) < 0) {
+            _stats[d->dst].overflow++;
+        }
+        else {
+            _stats[d->dst].rx++;
+            _kick[d->dst] = true;
+        }
+        _pop();
+    }
+}
+
+static void _notify(void)
+{
+    struct sockaddr_un addr;
+    const uint8_t kick = 0;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    for (unsigned i = 0; i < _numof; i++) {
+        if (!_kick[i]) {
+            continue;
+        }
+        _kick[i] = false;
+        snprintf(addr.sun_path, sizeof(addr.sun_path), VRADIO_NODE_SOCK_FMT,
+                 _name, i);
+        /* a full socket buffer already holds a notification */
+        sendto(_sock, &kick, sizeof(kick), 0, (struct sockaddr *)&addr,
+               sizeof(addr));
+    }
+}
+
+static void _print_stats(void)
+{
+    printf("%4s %10s %10s %10s %10s %10s\n",
+           "node", "tx", "rx", "lost", "missed", "overflow");
+    for (unsigned i = 0; i < _numof; i++) {
+        printf("%4u %10lu %10lu %10lu %10lu %10lu\n", i, _stats[i].tx,
+               _stats[i].rx, _stats[i].lost, _stats[i].missed,
+               _stats[i].overflow);
+    }
+    if (_queue_overflow) {
+        printf("delivery queue overflows: %lu\n", _queue_overflow);
+    }
+    fflush(stdout);
+}
+
+static void _signal(int sig)
+{
+    if (sig == SIGUSR1) {
+        _dump = 1;
+    }
+    else {
+        _stop = 1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *topo = "mesh";
+    const char *fname = NULL;
+    long seed = (long)time(NULL);
+    int c;
+
+    while ((c = getopt(argc, argv, "m:n:g:t:l:d:r:s:Avh")) != -1) {
+        switch (c) {
+            case 'm':
+                _name = optarg;
+                break;
+            case 'n':
+                _numof = strtoul(optarg, NULL, 0);
+                if ((_numof == 0) || (_numof > VRADIO_MEDIUM_NODES_MAX)) {
+                    _usage(argv[0]);
+                }
+                break;
+            case 'g':
+                topo = optarg;
+                break;
+            case 't':
+                fname = optarg;
+                break;
+            case 'l':
+                _default.loss = strtod(optarg, NULL);
+                if ((_default.loss < 0.0) || (_default.loss > 1.0)) {
+                    _usage(argv[0]);
+                }
+                break;
+            case 'd':
+                _default.latency = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                _default.rssi = (int8_t)strtol(optarg, NULL, 0);
+                break;
+            case 's':
+                seed = strtol(optarg, NULL, 0);
+                break;
+            case 'A':
+                _airtime = false;
+                break;
+            case 'v':
+                _verbose = true;
+                break;
+            default:
+                _usage(argv[0]);
+        }
+    }
+    if (optind != argc) {
+        _usage(argv[0]);
+    }
+
+    srand48(seed);
+    if (fname != NULL) {
+        _load(fname);
+    }
+    else {
+        _generate(topo);
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = _signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGUSR1, &sa, NULL);
+
+    _create();
+    printf("vradiod: medium %s with %u nodes ready, seed %ld\n", _name, _numof,
+           seed);
+    fflush(stdout);
+
+    while (!_stop) {
+        struct pollfd pfd = { .fd = _sock, .events = POLLIN };
+        struct timespec timeout, *t = NULL;
+        uint64_t now = _now();
+
+        if (_queued > 0) {
+            uint64_t wait = (_queue[0].due > now) ? _queue[0].due - now : 0;
+            timeout.tv_sec = wait / 1000000;
+            timeout.tv_nsec = (wait % 1000000) * 1000;
+            t = &timeout;
+        }
+        if ((ppoll(&pfd, 1, t, NULL) == -1) && (errno != EINTR)) {
+            perror("ppoll");
+            break;
+        }
+        if (pfd.revents & POLLIN) {
+            uint8_t buf[16];
+            while (recv(_sock, buf, sizeof(buf), 0) > 0) {}
+        }
+
+        now = _now();
+        /* also look at the rings without notification, a node that found its
+         * TX ring full does not notify again */
+        _collect(now);
+        _deliver(now);
+        _notify();
+
+        if (_dump) {
+            _dump = 0;
+            _print_stats();
+        }
+    }
+
+    _print_stats();
+    _destroy();
+    return 0;
+}
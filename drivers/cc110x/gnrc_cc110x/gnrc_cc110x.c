@@ -188,7 +188,7 @@ static const gnrc_netif_ops_t _cc110x_ops = {
     .set = gnrc_netif_set_from_netdev,
 };
 
-gnrc_netif_t *gnrc_netif_cc110x_create(char *stack, int stacksize, char priority,
+gnrc_netif_t *gnrc_netif_cc110x_create(char *stack, int stacksize, uint8_t priority,
                                        char *name, netdev_t *dev)
 {
     return gnrc_netif_create(stack, stacksize, priority, name, dev,
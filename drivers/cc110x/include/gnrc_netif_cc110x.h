@@ -24,7 +24,7 @@
 extern "C" {
 #endif
 
-gnrc_netif_t *gnrc_netif_cc110x_create(char *stack, int stacksize, char priority,
+gnrc_netif_t *gnrc_netif_cc110x_create(char *stack, int stacksize, uint8_t priority,
                                        char *name, netdev_t *dev);
 
 #ifdef __cplusplus
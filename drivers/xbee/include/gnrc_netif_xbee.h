@@ -25,7 +25,7 @@ extern "C" {
 #endif
 
 gnrc_netif_t *gnrc_netif_xbee_create(char *stack, int stacksize,
-                                     char priority, char *name,
+                                     uint8_t priority, char *name,
                                      netdev_t *dev);
 
 #ifdef __cplusplus
@@ -20,7 +20,13 @@ PSEUDOMODULES += gnrc_ipv6_nib_router
 PSEUDOMODULES += gnrc_netdev_default
 PSEUDOMODULES += gnrc_neterr
 PSEUDOMODULES += gnrc_netapi_callbacks
+PSEUDOMODULES += gnrc_netapi_inline
 PSEUDOMODULES += gnrc_netapi_mbox
+PSEUDOMODULES += gnrc_netif_bulk
+PSEUDOMODULES += gnrc_netif_poll
+PSEUDOMODULES += gnrc_netif_txq
+PSEUDOMODULES += gnrc_netreg_hash
+PSEUDOMODULES += gnrc_pktbuf_stats
 PSEUDOMODULES += gnrc_sixlowpan_border_router_default
 PSEUDOMODULES += gnrc_sixlowpan_default
 PSEUDOMODULES += gnrc_sixlowpan_iphc_nhc
@@ -48,8 +54,14 @@ PSEUDOMODULES += lwip_tcp
 PSEUDOMODULES += lwip_udp
 PSEUDOMODULES += lwip_udplite
 PSEUDOMODULES += mpu_stack_guard
+PSEUDOMODULES += mtd_native_mmap
 PSEUDOMODULES += nanocoap_%
+PSEUDOMODULES += native_hrtimer
+PSEUDOMODULES += native_vtime
 PSEUDOMODULES += netdev_default
+PSEUDOMODULES += netdev_tap_batch
+PSEUDOMODULES += netdev_tap_mq
+PSEUDOMODULES += netdev_tap_vnet_hdr
 PSEUDOMODULES += netif
 PSEUDOMODULES += netstats
 PSEUDOMODULES += netstats_l2
@@ -66,11 +78,14 @@ PSEUDOMODULES += prng_%
 PSEUDOMODULES += saul_adc
 PSEUDOMODULES += saul_default
 PSEUDOMODULES += saul_gpio
+PSEUDOMODULES += sched_round_robin
 PSEUDOMODULES += schedstatistics
 PSEUDOMODULES += sock
 PSEUDOMODULES += sock_ip
 PSEUDOMODULES += sock_tcp
 PSEUDOMODULES += sock_udp
+PSEUDOMODULES += xtimer_slack
+PSEUDOMODULES += xtimer_wheel
 
 # print ascii representation in function od_hex_dump()
 PSEUDOMODULES += od_string
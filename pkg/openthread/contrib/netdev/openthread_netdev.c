@@ -167,7 +167,7 @@ kernel_pid_t openthread_get_pid(void) {
 }
 
 /* starts OpenThread thread */
-int openthread_netdev_init(char *stack, int stacksize, char priority,
+int openthread_netdev_init(char *stack, int stacksize, uint8_t priority,
                            const char *name, netdev_t *netdev) {
     netdev->driver->init(netdev);
     netdev->event_callback = _event_cb;
@@ -100,7 +100,7 @@ void openthread_radio_init(netdev_t *dev, uint8_t *tb, uint8_t *rb);
  * @return  PID of OpenThread thread
  * @return  -EINVAL if there was an error creating the thread
  */
-int openthread_netdev_init(char *stack, int stacksize, char priority, const char *name, netdev_t *netdev);
+int openthread_netdev_init(char *stack, int stacksize, uint8_t priority, const char *name, netdev_t *netdev);
 
 /**
  * @brief   get PID of OpenThread thread.
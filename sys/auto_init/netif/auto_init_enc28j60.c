@@ -30,7 +30,7 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define ENC28J60_MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define ENC28J60_MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT + GNRC_NETIF_EXTRA_STACKSIZE)
 #ifndef ENC28J60_MAC_PRIO
 #define ENC28J60_MAC_PRIO        (GNRC_NETIF_PRIO)
 #endif
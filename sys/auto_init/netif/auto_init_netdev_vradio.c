@@ -0,0 +1,66 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup auto_init_gnrc_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for native virtual radios
+ */
+
+#ifdef MODULE_NETDEV_VRADIO
+
+#include "log.h"
+#include "debug.h"
+#include "net/gnrc/netif/ieee802154.h"
+#ifdef MODULE_GNRC_LWMAC
+#include "net/gnrc/lwmac/lwmac.h"
+#endif
+#ifdef MODULE_GNRC_GOMACH
+#include "net/gnrc/gomach/gomach.h"
+#endif
+#include "net/gnrc.h"
+
+#include "netdev_vradio.h"
+
+#define VRADIO_MAC_STACKSIZE        (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE \
+                                     + GNRC_NETIF_EXTRA_STACKSIZE)
+#define VRADIO_MAC_PRIO             (GNRC_NETIF_PRIO)
+
+static netdev_vradio_t netdev_vradio[NETDEV_VRADIO_MAX];
+static char _netdev_vradio_stack[NETDEV_VRADIO_MAX][VRADIO_MAC_STACKSIZE];
+
+void auto_init_netdev_vradio(void)
+{
+    for (unsigned i = 0; i < NETDEV_VRADIO_MAX; i++) {
+        const netdev_vradio_params_t *p = &netdev_vradio_params[i];
+
+        LOG_DEBUG("[auto_init_netif] initializing netdev_vradio #%u as node "
+                  "%u on medium %s\n", i, p->node, p->medium);
+
+        netdev_vradio_setup(&netdev_vradio[i], p);
+#if defined(MODULE_GNRC_GOMACH)
+        gnrc_netif_gomach_create(_netdev_vradio_stack[i], VRADIO_MAC_STACKSIZE,
+                                 VRADIO_MAC_PRIO, "vradio-gomach",
+                                 (netdev_t *)&netdev_vradio[i]);
+#elif defined(MODULE_GNRC_LWMAC)
+        gnrc_netif_lwmac_create(_netdev_vradio_stack[i], VRADIO_MAC_STACKSIZE,
+                                VRADIO_MAC_PRIO, "vradio-lwmac",
+                                (netdev_t *)&netdev_vradio[i]);
+#else
+        gnrc_netif_ieee802154_create(_netdev_vradio_stack[i],
+                                     VRADIO_MAC_STACKSIZE, VRADIO_MAC_PRIO,
+                                     "vradio", (netdev_t *)&netdev_vradio[i]);
+#endif
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NETDEV_VRADIO */
+/** @} */
@@ -33,7 +33,7 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define SLIPDEV_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#define SLIPDEV_STACKSIZE       (THREAD_STACKSIZE_DEFAULT + GNRC_NETIF_EXTRA_STACKSIZE)
 #ifndef SLIPDEV_PRIO
 #define SLIPDEV_PRIO            (GNRC_NETIF_PRIO)
 #endif
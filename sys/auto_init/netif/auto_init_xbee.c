@@ -35,7 +35,7 @@
 /**
  * @brief   Define stack parameters for the MAC layer thread
  */
-#define XBEE_MAC_STACKSIZE           (THREAD_STACKSIZE_DEFAULT)
+#define XBEE_MAC_STACKSIZE           (THREAD_STACKSIZE_DEFAULT + GNRC_NETIF_EXTRA_STACKSIZE)
 #ifndef XBEE_MAC_PRIO
 #define XBEE_MAC_PRIO                (GNRC_NETIF_PRIO)
 #endif
@@ -350,7 +350,7 @@ static void *_can_device_thread(void *args)
     return NULL;
 }
 
-kernel_pid_t can_device_init(char *stack, int stacksize, char priority,
+kernel_pid_t can_device_init(char *stack, int stacksize, uint8_t priority,
                              const char *name, candev_dev_t *params)
 {
     kernel_pid_t res;
@@ -736,7 +736,7 @@ static void *_isotp_thread(void *args)
     return NULL;
 }
 
-kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *name)
+kernel_pid_t isotp_init(char *stack, int stacksize, uint8_t priority, const char *name)
 {
     kernel_pid_t res;
 
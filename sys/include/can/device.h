@@ -96,7 +96,7 @@ typedef struct candev_dev {
  *
  * @return the pid of the created thread
  */
-kernel_pid_t can_device_init(char *stack, int stacksize, char priority,
+kernel_pid_t can_device_init(char *stack, int stacksize, uint8_t priority,
                              const char *name, candev_dev_t *params);
 
 /**
@@ -136,7 +136,7 @@ struct isotp {
  *
  * @return the pid of the isotp thread
  */
-kernel_pid_t isotp_init(char *stack, int stacksize, char priority, const char *name);
+kernel_pid_t isotp_init(char *stack, int stacksize, uint8_t priority, const char *name);
 
 /**
  * @brief Send data through an isotp channel
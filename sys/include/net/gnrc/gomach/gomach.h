@@ -362,7 +362,7 @@ extern "C" {
  * @return  NULL, on error.
  */
 gnrc_netif_t *gnrc_netif_gomach_create(char *stack, int stacksize,
-                                       char priority, char *name,
+                                       uint8_t priority, char *name,
                                        netdev_t *dev);
 
 #ifdef __cplusplus
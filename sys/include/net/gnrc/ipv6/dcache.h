@@ -0,0 +1,167 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_dcache IPv6 destination cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Caches the next-hop determination of @ref net_gnrc_ipv6 per
+ *              destination
+ *
+ * Without this module, @ref net_gnrc_ipv6 asks the @ref net_gnrc_ipv6_nib
+ * for the next hop and link-layer address and selects a source address for
+ * every unicast packet it sends. With the `gnrc_ipv6_dcache` module, the
+ * results of that are kept in a direct-mapped cache keyed by destination
+ * address (see [RFC 4861, section 5.1]
+ * (https://tools.ietf.org/html/rfc4861#section-5.1)), so subsequent packets
+ * to the same destination are sent without consulting the NIB.
+ *
+ * The whole cache is invalidated whenever the NIB changes (e.g. on received
+ * neighbor discovery messages, timeouts and NIB configuration) and whenever
+ * an address is added to or removed from an interface, so the NIB's state
+ * machines are still run for the first packet after every such change.
+ *
+ * To use, add the module `gnrc_ipv6_dcache` to the `USEMODULE` macro in your
+ * application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_ipv6_dcache
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @{
+ *
+ * @file
+ * @brief       IPv6 destination cache definitions
+ */
+#ifndef NET_GNRC_IPV6_DCACHE_H
+#define NET_GNRC_IPV6_DCACHE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the destination cache
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_IPV6_DCACHE_SIZE
+#define GNRC_IPV6_DCACHE_SIZE       (8U)
+#endif
+
+/**
+ * @brief   Destination cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;                /**< destination address */
+    ipv6_addr_t next_hop;           /**< next hop towards gnrc_ipv6_dcache_entry_t::dst */
+    /**
+     * @brief   Source address for gnrc_ipv6_dcache_entry_t::dst
+     *
+     * The unspecified address if not selected yet.
+     */
+    ipv6_addr_t src;
+    gnrc_netif_t *netif;            /**< outgoing interface */
+    uint32_t gen;                   /**< generation the entry was added in */
+    /**
+     * @brief   Interface requested by the sender, KERNEL_PID_UNDEF for none
+     */
+    kernel_pid_t iface;
+    /**
+     * @brief   Link-layer address of gnrc_ipv6_dcache_entry_t::next_hop
+     */
+    uint8_t l2addr[GNRC_IPV6_NIB_L2ADDR_MAX_LEN];
+    uint8_t l2addr_len;             /**< length of gnrc_ipv6_dcache_entry_t::l2addr */
+} gnrc_ipv6_dcache_entry_t;
+
+/**
+ * @brief   Destination cache counters
+ */
+typedef struct {
+    uint32_t hits;                  /**< lookups answered by the cache */
+    uint32_t misses;                /**< lookups that went to the NIB */
+    uint32_t flushes;               /**< invalidations of the cache */
+} gnrc_ipv6_dcache_stats_t;
+
+#if defined(MODULE_GNRC_IPV6_DCACHE) || defined(DOXYGEN)
+/**
+ * @brief   Looks up the cache entry for a destination
+ *
+ * @pre `dst != NULL`
+ *
+ * @note    The cache is only to be used by the IPv6 thread.
+ *
+ * @param[in] dst   A destination address.
+ * @param[in] iface The interface the sender requested, KERNEL_PID_UNDEF for
+ *                  none.
+ *
+ * @return  The entry for (@p dst, @p iface).
+ * @return  NULL, if there is none. gnrc_ipv6_dcache_add() may then be called
+ *          with the result of the NIB.
+ */
+gnrc_ipv6_dcache_entry_t *gnrc_ipv6_dcache_get(const ipv6_addr_t *dst,
+                                               kernel_pid_t iface);
+
+/**
+ * @brief   Adds the next hop for a destination to the cache
+ *
+ * Replaces the entry of another destination that maps to the same slot.
+ * Nothing is added if the cache was invalidated since the last call of
+ * gnrc_ipv6_dcache_get(), since @p nce may already be outdated then.
+ *
+ * @pre `(dst != NULL) && (netif != NULL) && (nce != NULL)`
+ *
+ * @param[in] dst   A destination address.
+ * @param[in] iface The interface the sender requested, KERNEL_PID_UNDEF for
+ *                  none.
+ * @param[in] netif The outgoing interface for @p dst.
+ * @param[in] nce   The next hop for @p dst as returned by
+ *                  gnrc_ipv6_nib_get_next_hop_l2addr().
+ *
+ * @return  The new entry.
+ * @return  NULL, if the cache was invalidated in between.
+ */
+gnrc_ipv6_dcache_entry_t *gnrc_ipv6_dcache_add(const ipv6_addr_t *dst,
+                                               kernel_pid_t iface,
+                                               gnrc_netif_t *netif,
+                                               const gnrc_ipv6_nib_nc_t *nce);
+
+/**
+ * @brief   Invalidates all entries of the cache
+ *
+ * Called by the NIB and @ref net_gnrc_netif on every change that may alter
+ * a next hop or source address selection. May be called from any thread.
+ */
+void gnrc_ipv6_dcache_flush(void);
+
+/**
+ * @brief   Gets the counters of the cache
+ *
+ * @param[out] stats    The counters.
+ */
+void gnrc_ipv6_dcache_get_stats(gnrc_ipv6_dcache_stats_t *stats);
+
+/**
+ * @brief   Prints the valid entries and counters of the cache
+ */
+void gnrc_ipv6_dcache_print(void);
+#else
+static inline void gnrc_ipv6_dcache_flush(void)
+{
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_DCACHE_H */
+/** @} */
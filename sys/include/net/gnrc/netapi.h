@@ -51,6 +51,41 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_inline   Run-to-completion receive path
+ * @ingroup     net_gnrc_netapi
+ * @brief       Process received packets inline in the interface's thread
+ * @{
+ * @details With the submodule `gnrc_netapi_inline`, @ref net_gnrc_sixlowpan,
+ *          @ref net_gnrc_ipv6 and @ref net_gnrc_udp register at the
+ *          @ref net_gnrc_netreg with a @ref net_gnrc_netapi_callbacks
+ *          "callback" instead of their thread. A received packet is then
+ *          handled by every one of these layers in the thread that
+ *          dispatched it, usually the one of its @ref net_gnrc_netif, and
+ *          only the final hand-over to the application goes through a
+ *          message queue.
+ *
+ * A layer still queues a packet to its own thread whenever handling it would
+ * touch state owned by that thread, i.e.
+ *
+ * - 6LoWPAN fragments, which go to the reassembly buffer,
+ * - IPv6 packets that are not addressed to the receiving interface or that
+ *   do not carry UDP directly (e.g. ICMPv6 and neighbor discovery), and
+ * - every packet to be sent.
+ *
+ * Since the interface's thread now runs the receive functions of all three
+ * layers, its stack must be sized accordingly. The interfaces created by
+ * `auto_init` get @ref GNRC_NETIF_EXTRA_STACKSIZE added to their stacks for
+ * that, interfaces created by the application must account for it
+ * themselves.
+ *
+ * To use, add the module `gnrc_netapi_inline` to the `USEMODULE` macro in
+ * your application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_inline
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
  */
@@ -92,6 +127,17 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   Maximum number of packets handed to a subscriber per wakeup by
+ *          gnrc_netapi_dispatch_bulk()
+ *
+ * Messages are assembled on the stack of the dispatching thread, so every
+ * increment costs `sizeof(msg_t)` bytes of stack.
+ */
+#ifndef GNRC_NETAPI_BULK_SIZE
+#define GNRC_NETAPI_BULK_SIZE           (8U)
+#endif
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -127,6 +173,27 @@ int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt);
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx, uint16_t cmd,
                          gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Sends @p cmd for a burst of packets to all subscribers to
+ *          (@p type, @p demux_ctx).
+ *
+ * Works like calling gnrc_netapi_dispatch() for every packet in @p pkts, but
+ * subscribing threads are sent the messages with msg_send_bulk(), so a
+ * burst of up to @ref GNRC_NETAPI_BULK_SIZE packets wakes each of them only
+ * once.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] cmd       command for all subscribers
+ * @param[in] pkts      array of @p num pointers into the packet buffer
+ * @param[in] num       number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+int gnrc_netapi_dispatch_bulk(gnrc_nettype_t type, uint32_t demux_ctx,
+                              uint16_t cmd, gnrc_pktsnip_t **pkts,
+                              unsigned num);
+
 /**
  * @brief   Sends a @ref GNRC_NETAPI_MSG_TYPE_SND command to all subscribers to
  *          (@p type, @p demux_ctx).
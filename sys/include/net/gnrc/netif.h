@@ -14,6 +14,12 @@
  * Network interfaces in the context of GNRC are threads for protocols that are
  * below the network layer.
  *
+ * With the `gnrc_netif_bulk` module, the packets a device hands over during
+ * one call of its `isr()` function are passed on with
+ * gnrc_netapi_dispatch_bulk(), so a burst of received frames (e.g. from
+ * `netdev_tap_batch`) wakes each subscriber only once. The module is used by
+ * default with `netdev_tap_batch`.
+ *
  * @{
  *
  * @file
@@ -44,6 +50,9 @@
 #ifdef MODULE_GNRC_MAC
 #include "net/gnrc/netif/mac.h"
 #endif
+#ifdef MODULE_GNRC_NETIF_TXQ
+#include "net/gnrc/netif/txq.h"
+#endif
 #include "net/netdev.h"
 #include "rmutex.h"
 
@@ -69,6 +78,9 @@ typedef struct {
 #if defined(MODULE_GNRC_MAC) || DOXYGEN
     gnrc_netif_mac_t mac;                  /**< @ref net_gnrc_mac component */
 #endif  /* MODULE_GNRC_MAC */
+#if defined(MODULE_GNRC_NETIF_TXQ) || DOXYGEN
+    gnrc_netif_txq_t txq;                   /**< @ref net_gnrc_netif_txq component */
+#endif
     /**
      * @brief   Flags for the interface
      *
@@ -93,6 +105,27 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETIF_POLL) || DOXYGEN
+    /**
+     * @brief   Maximum number of frames handled per wakeup
+     *
+     * @note    Only available with module `gnrc_netif_poll`
+     *
+     * @see     GNRC_NETIF_RX_BUDGET
+     */
+    uint16_t rx_budget;
+    uint16_t rx_frames;                     /**< frames handled in this wakeup */
+    volatile uint8_t rx_poll;               /**< RX polling state */
+#endif
+#if defined(MODULE_GNRC_NETIF_BULK) || DOXYGEN
+    /**
+     * @brief   Received packets not passed on yet
+     *
+     * @note    Only available with module `gnrc_netif_bulk`
+     */
+    gnrc_pktsnip_t *rx_pkts[GNRC_NETAPI_BULK_SIZE];
+    uint8_t rx_pkts_num;                    /**< number of packets in gnrc_netif_t::rx_pkts */
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
@@ -222,7 +255,7 @@ struct gnrc_netif_ops {
  *
  * @return  The network interface on success.
  */
-gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
+gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, uint8_t priority,
                                 const char *name, netdev_t *dev,
                                 const gnrc_netif_ops_t *ops);
 
@@ -44,6 +44,39 @@ extern "C" {
 #define GNRC_NETIF_PRIO            (THREAD_PRIORITY_MAIN - 5)
 #endif
 
+/**
+ * @brief   Stack space added to the thread of every network interface
+ *
+ * With @ref net_gnrc_netapi_inline "gnrc_netapi_inline", the interface's
+ * thread also runs the receive functions of @ref net_gnrc_sixlowpan,
+ * @ref net_gnrc_ipv6 and @ref net_gnrc_udp, so its stack needs to hold their
+ * frames as well.
+ */
+#ifndef GNRC_NETIF_EXTRA_STACKSIZE
+#ifdef MODULE_GNRC_NETAPI_INLINE
+#define GNRC_NETIF_EXTRA_STACKSIZE (THREAD_STACKSIZE_DEFAULT)
+#else
+#define GNRC_NETIF_EXTRA_STACKSIZE (0)
+#endif
+#endif
+
+/**
+ * @brief   Default maximum number of frames handled per wakeup with
+ *          `gnrc_netif_poll`
+ *
+ * With the `gnrc_netif_poll` module, the first RX interrupt of a device
+ * wakes its interface's thread and masks further RX events. The thread then
+ * polls the device until no new frame arrived while handling the last one,
+ * or until it handled this many frames, and unmasks RX events again.
+ * Frames left over at that point are handled after the messages that queued
+ * up in the meantime, e.g. packets to send.
+ *
+ * Can be changed at runtime with @ref NETOPT_RX_BUDGET.
+ */
+#ifndef GNRC_NETIF_RX_BUDGET
+#define GNRC_NETIF_RX_BUDGET       (16U)
+#endif
+
 /**
  * @brief   Number of multicast addresses needed for @ref net_gnrc_rpl "RPL".
  *
@@ -41,7 +41,7 @@ extern "C" {
  *
  * @return  The network interface on success.
  */
-gnrc_netif_t *gnrc_netif_ethernet_create(char *stack, int stacksize, char priority,
+gnrc_netif_t *gnrc_netif_ethernet_create(char *stack, int stacksize, uint8_t priority,
                                          char *name, netdev_t *dev);
 
 #ifdef __cplusplus
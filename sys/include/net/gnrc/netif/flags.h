@@ -134,6 +134,20 @@ enum {
  *          packet
  */
 #define GNRC_NETIF_FLAGS_MAC_RX_STARTED            (0x00008000U)
+
+/**
+ * @brief   The device verifies transport layer checksums of received packets
+ *
+ * @see @ref NETOPT_RX_CHECKSUM_OFFLOAD
+ */
+#define GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD           (0x00010000U)
+
+/**
+ * @brief   The device completes transport layer checksums of packets to send
+ *
+ * @see @ref NETOPT_TX_CHECKSUM_OFFLOAD
+ */
+#define GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD           (0x00020000U)
 /** @} */
 
 #ifdef __cplusplus
@@ -291,6 +291,23 @@ int gnrc_netif_ipv6_group_idx(gnrc_netif_t *netif,
  *          gnrc_netif_t::device_type is not supported.
  */
 int gnrc_netif_ipv6_get_iid(gnrc_netif_t *netif, eui64_t *eui64);
+
+/**
+ * @brief   Checks if the network device already verified the checksum of a
+ *          received transport layer message
+ *
+ * This is the case if the message directly follows the IPv6 header of the
+ * packet and the packet was received on an interface with
+ * @ref GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD set.
+ *
+ * @param[in] ipv6      the IPv6 header of the received packet
+ * @param[in] protnum   protocol number of the transport layer message
+ *
+ * @return  true, if the checksum does not need to be verified
+ * @return  false, if the checksum needs to be verified
+ */
+bool gnrc_netif_ipv6_rx_csum_offloaded(const gnrc_pktsnip_t *ipv6,
+                                       uint8_t protnum);
 #endif  /* MODULE_GNRC_IPV6 */
 
 /**
@@ -414,6 +431,59 @@ static inline bool gnrc_netif_is_6lbr(const gnrc_netif_t *netif)
 #define gnrc_netif_is_6lbr(netif)               (false)
 #endif
 
+#if defined(MODULE_GNRC_NETIF_TXQ) || defined(DOXYGEN)
+/**
+ * @brief   Initializes the transmission queue of an interface
+ *
+ * Enables @ref NETOPT_TX_END_IRQ on the device. Packets are only queued if
+ * that succeeds and @p async is true.
+ *
+ * @param[in] netif the network interface
+ * @param[in] async the device events of @p netif reach gnrc_netif
+ *
+ * @internal
+ */
+void gnrc_netif_txq_init(gnrc_netif_t *netif, bool async);
+
+/**
+ * @brief   Sends a packet or queues it if the device is still busy
+ *
+ * @param[in] netif the network interface
+ * @param[in] pkt   the packet to send
+ *
+ * @internal
+ */
+void gnrc_netif_txq_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Signals the end of a transmission and sends the next packet
+ *
+ * @param[in] netif the network interface
+ *
+ * @internal
+ */
+void gnrc_netif_txq_tx_done(gnrc_netif_t *netif);
+
+/**
+ * @brief   Ends a transmission the device won't report the end of anymore,
+ *          e.g. after a change of @ref NETOPT_STATE, and sends the next packet
+ *
+ * @param[in] netif the network interface
+ *
+ * @internal
+ */
+void gnrc_netif_txq_reset(gnrc_netif_t *netif);
+
+/**
+ * @brief   Handles a @ref GNRC_NETIF_TXQ_MSG_TYPE_TIMEOUT message
+ *
+ * @param[in] netif the network interface
+ *
+ * @internal
+ */
+void gnrc_netif_txq_timeout(gnrc_netif_t *netif);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
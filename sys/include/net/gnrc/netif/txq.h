@@ -0,0 +1,158 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_txq  Transmission queue
+ * @ingroup     net_gnrc_netif
+ * @brief       Prioritized queue for packets the device is not ready to send
+ *
+ * With the `gnrc_netif_txq` module, an interface whose device signals the
+ * end of a transmission (@ref NETOPT_TX_END_IRQ) only hands one packet at a
+ * time to the device. Packets to be sent while a transmission is in
+ * progress wait in a bounded @ref net_gnrc_priority_pktqueue and are sent on
+ * @ref NETDEV_EVENT_TX_COMPLETE, @ref NETDEV_EVENT_TX_MEDIUM_BUSY or
+ * @ref NETDEV_EVENT_TX_NOACK.
+ *
+ * Packets are queued by class, see @ref gnrc_netif_txq_prio_t. When the queue
+ * is full, a packet replaces the newest packet of a lower class, or is
+ * dropped if there is none. Once the queue holds
+ * @ref GNRC_NETIF_TXQ_ECN_THRESHOLD packets, queued IPv6 packets that are
+ * ECN-capable are marked with "Congestion Experienced" instead (RFC 3168).
+ *
+ * A transmission is also considered to be over when the state of the device
+ * is changed with @ref NETOPT_STATE (e.g. on a reset), and after
+ * @ref GNRC_NETIF_TXQ_TX_TIMEOUT, in case the device never reports its end.
+ *
+ * Interfaces whose device does not support @ref NETOPT_TX_END_IRQ, or
+ * handles device events itself, send every packet right away as before.
+ * @{
+ *
+ * @file
+ * @brief       Transmission queue definitions for @ref net_gnrc_netif
+ */
+#ifndef NET_GNRC_NETIF_TXQ_H
+#define NET_GNRC_NETIF_TXQ_H
+
+#include <stdint.h>
+
+#include "msg.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/priority_pktqueue.h"
+#include "net/ieee802154.h"
+#include "net/ipv6.h"
+#include "net/sixlowpan.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Bytes of a datagram carried by a subsequent fragment
+ * @internal
+ */
+#define GNRC_NETIF_TXQ_FRAG_PAYLOAD                                         \
+    (((IEEE802154_FRAME_LEN_MAX - IEEE802154_MAX_HDR_LEN -                  \
+       IEEE802154_FCS_LEN - sizeof(sixlowpan_frag_n_t)) / 8U) * 8U)
+
+/**
+ * @brief   Number of IEEE 802.15.4 frames a 6LoWPAN datagram of the IPv6
+ *          minimum MTU is fragmented into at most
+ *
+ * Subsequent fragments carry a multiple of 8 bytes of the datagram each,
+ * after a MAC header of up to @ref IEEE802154_MAX_HDR_LEN bytes.
+ */
+#define GNRC_NETIF_TXQ_FRAGS_NUMOF                                          \
+    ((IPV6_MIN_MTU + GNRC_NETIF_TXQ_FRAG_PAYLOAD - 1) /                     \
+     GNRC_NETIF_TXQ_FRAG_PAYLOAD)
+
+/**
+ * @brief   Maximum number of packets in the queue of an interface
+ *
+ * Packets are not held back before they reach the queue, so with
+ * `gnrc_sixlowpan_frag` the queue holds all fragments of a datagram of the
+ * IPv6 minimum MTU, which 6LoWPAN hands to the interface back-to-back, and
+ * leaves room for some other packets.
+ */
+#ifndef GNRC_NETIF_TXQ_SIZE
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+#define GNRC_NETIF_TXQ_SIZE             (GNRC_NETIF_TXQ_FRAGS_NUMOF + 4U)
+#else
+#define GNRC_NETIF_TXQ_SIZE             (8U)
+#endif
+#endif
+
+/**
+ * @brief   Queue length from which ECN-capable IPv6 packets are marked with
+ *          "Congestion Experienced"
+ *
+ * Set to a value larger than @ref GNRC_NETIF_TXQ_SIZE to never mark packets.
+ */
+#ifndef GNRC_NETIF_TXQ_ECN_THRESHOLD
+#define GNRC_NETIF_TXQ_ECN_THRESHOLD    (GNRC_NETIF_TXQ_SIZE / 2)
+#endif
+
+/**
+ * @brief   Time in microseconds after which a transmission is considered to
+ *          be over if the device did not report its end
+ */
+#ifndef GNRC_NETIF_TXQ_TX_TIMEOUT
+#define GNRC_NETIF_TXQ_TX_TIMEOUT       (100U * US_PER_MS)
+#endif
+
+/**
+ * @brief   Message type of the transmission timeout of an interface
+ */
+#define GNRC_NETIF_TXQ_MSG_TYPE_TIMEOUT (0x1235)
+
+/**
+ * @brief   Priority classes of queued packets, sent in this order
+ */
+typedef enum {
+    /**
+     * @brief   Routing and control traffic: ICMPv6, including neighbor
+     *          discovery and RPL, and the network control DSCPs CS6 and CS7
+     */
+    GNRC_NETIF_TXQ_PRIO_CTRL = 0,
+    GNRC_NETIF_TXQ_PRIO_DATA,       /**< all other traffic */
+    GNRC_NETIF_TXQ_PRIO_BULK,       /**< the lower effort DSCP CS1 (RFC 8622) */
+} gnrc_netif_txq_prio_t;
+
+/**
+ * @brief   Counters of a transmission queue
+ */
+typedef struct {
+    uint32_t queued;        /**< packets that had to wait for the device */
+    uint32_t dropped;       /**< packets dropped since the queue was full */
+    uint32_t marked;        /**< packets marked with "Congestion Experienced" */
+    uint32_t timeouts;      /**< transmissions ended by the timeout */
+    uint16_t max_len;       /**< largest queue length seen */
+} gnrc_netif_txq_stats_t;
+
+/**
+ * @brief   Transmission queue component of @ref gnrc_netif_t
+ */
+typedef struct {
+    gnrc_priority_pktqueue_t queue;                         /**< the queue */
+    /**
+     * @brief   Nodes of gnrc_netif_txq_t::queue
+     */
+    gnrc_priority_pktqueue_node_t nodes[GNRC_NETIF_TXQ_SIZE];
+    gnrc_netif_txq_stats_t stats;                           /**< counters */
+    xtimer_t timer;                                         /**< transmission timeout */
+    msg_t timeout_msg;                                      /**< message of gnrc_netif_txq_t::timer */
+    uint32_t tx_start;                                      /**< start of the current transmission */
+    uint8_t len;                                            /**< queue length */
+    uint8_t flags;                                          /**< state flags */
+} gnrc_netif_txq_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_TXQ_H */
+/** @} */
@@ -72,6 +72,21 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets per type with `gnrc_netreg_hash`
+ *
+ * With the `gnrc_netreg_hash` module the entries of a type are distributed
+ * over this many buckets by their demux context, and entries with the same
+ * demux context are kept next to each other. A lookup then only scans one
+ * bucket and gnrc_netreg_getnext() is O(1), at the cost of
+ * `GNRC_NETTYPE_NUMOF * GNRC_NETREG_HASH_SIZE` pointers of RAM.
+ *
+ * Must be a power of 2 and not larger than 256.
+ */
+#ifndef GNRC_NETREG_HASH_SIZE
+#define GNRC_NETREG_HASH_SIZE       (8)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -93,7 +108,7 @@ typedef enum {
  *
  * @return  An initialized netreg entry
  */
-#ifdef MODULE_GNRC_NETAPI_MBOX
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
                                                       { pid } }
@@ -115,6 +115,14 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#ifdef MODULE_GNRC_PKTBUF_STATS
+    /**
+     * @brief   Type the snip is accounted to in the packet buffer statistics
+     *
+     * @internal
+     */
+    gnrc_nettype_t owner;
+#endif
 } gnrc_pktsnip_t;
 
 /**
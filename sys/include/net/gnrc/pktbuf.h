@@ -58,6 +58,90 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Slab configuration of `gnrc_pktbuf_slab`
+ *
+ * The `gnrc_pktbuf_slab` implementation replaces the first-fit allocation in
+ * one array by slabs of fixed-size blocks: one for snip descriptors, one for
+ * small headers, one for link-layer frames and one for MTU-sized payloads.
+ * Allocating and releasing is O(1) and the buffer can not fragment; a full
+ * packet buffer is only reported if no block of sufficient size is left.
+ * Data larger than @ref GNRC_PKTBUF_SLAB_LARGE_SIZE can not be allocated.
+ *
+ * By default the data slabs share @ref GNRC_PKTBUF_SIZE: half of it goes to
+ * payloads, a quarter each to frames and headers (rounded up to whole
+ * blocks), and every data block gets a snip descriptor.
+ * @{
+ */
+/**
+ * @brief   Size of a block for headers
+ */
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (64)
+#endif
+
+/**
+ * @brief   Number of blocks for headers
+ */
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    ((GNRC_PKTBUF_SIZE / 4 + \
+                                          GNRC_PKTBUF_SLAB_SMALL_SIZE - 1) / \
+                                         GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#endif
+
+/**
+ * @brief   Size of a block for frames
+ *
+ * Fits a full IEEE 802.15.4 frame and most packets without a payload of
+ * their own, like acknowledgements and neighbor discovery messages.
+ */
+#ifndef GNRC_PKTBUF_SLAB_FRAME_SIZE
+#define GNRC_PKTBUF_SLAB_FRAME_SIZE     (128)
+#endif
+
+/**
+ * @brief   Number of blocks for frames
+ */
+#ifndef GNRC_PKTBUF_SLAB_FRAME_NUMOF
+#define GNRC_PKTBUF_SLAB_FRAME_NUMOF    ((GNRC_PKTBUF_SIZE / 4 + \
+                                          GNRC_PKTBUF_SLAB_FRAME_SIZE - 1) / \
+                                         GNRC_PKTBUF_SLAB_FRAME_SIZE)
+#endif
+
+/**
+ * @brief   Size of a block for payloads
+ *
+ * Fits a full Ethernet frame. Without Ethernet devices, a 6LoWPAN node only
+ * needs blocks for reassembled datagrams of the IPv6 minimum MTU of 1280
+ * bytes.
+ */
+#ifndef GNRC_PKTBUF_SLAB_LARGE_SIZE
+#if defined(MODULE_GNRC_SIXLOWPAN) && !defined(MODULE_NETDEV_ETH)
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1280)
+#else
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1536)
+#endif
+#endif
+
+/**
+ * @brief   Number of blocks for payloads
+ */
+#ifndef GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define GNRC_PKTBUF_SLAB_LARGE_NUMOF    ((GNRC_PKTBUF_SIZE / 2 + \
+                                          GNRC_PKTBUF_SLAB_LARGE_SIZE - 1) / \
+                                         GNRC_PKTBUF_SLAB_LARGE_SIZE)
+#endif
+
+/**
+ * @brief   Number of snip descriptors
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (GNRC_PKTBUF_SLAB_SMALL_NUMOF + \
+                                         GNRC_PKTBUF_SLAB_FRAME_NUMOF + \
+                                         GNRC_PKTBUF_SLAB_LARGE_NUMOF)
+#endif
+/** @} */
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -286,6 +370,89 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
 void gnrc_pktbuf_stats(void);
 #endif
 
+#if defined(MODULE_GNRC_PKTBUF_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Number of entries in gnrc_pktbuf_stats_t::types
+ *
+ * There is one entry for every @ref gnrc_nettype_t, starting with
+ * @ref GNRC_NETTYPE_IOVEC.
+ */
+#define GNRC_PKTBUF_STATS_TYPES     (GNRC_NETTYPE_NUMOF - GNRC_NETTYPE_IOVEC)
+
+/**
+ * @brief   Packet buffer usage of one @ref gnrc_nettype_t
+ *
+ * A snip is accounted to the type it was allocated or marked with, even if
+ * the layer changes gnrc_pktsnip_t::type later on.
+ */
+typedef struct {
+    size_t bytes;           /**< data bytes held by the snips */
+    uint16_t snips;         /**< number of snips */
+    uint16_t max_snips;     /**< maximum number of snips */
+    uint32_t fails;         /**< allocations that failed for this type */
+} gnrc_pktbuf_type_stats_t;
+
+/**
+ * @brief   Packet buffer statistics
+ *
+ * @note    Only available with the `gnrc_pktbuf_stats` module.
+ */
+typedef struct {
+    size_t size;            /**< capacity in bytes, 0 if unbounded */
+    size_t used;            /**< bytes in use, including snip descriptors */
+    /**
+     * @brief   Largest allocation that would currently succeed, in bytes
+     *
+     * 0 if unbounded.
+     */
+    size_t largest_free;
+    gnrc_pktbuf_type_stats_t types[GNRC_PKTBUF_STATS_TYPES];  /**< per type */
+} gnrc_pktbuf_stats_t;
+
+/**
+ * @brief   Gets the statistics of the packet buffer
+ *
+ * @note    Only available with the `gnrc_pktbuf_stats` module.
+ *
+ * @param[out] stats    The statistics.
+ */
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats);
+
+/**
+ * @brief   Gets the statistics of one type from packet buffer statistics
+ *
+ * @pre `GNRC_NETTYPE_IOVEC <= type < GNRC_NETTYPE_NUMOF`
+ *
+ * @param[in] stats     Statistics from gnrc_pktbuf_get_stats().
+ * @param[in] type      A type.
+ *
+ * @return  The statistics of @p type.
+ */
+static inline const gnrc_pktbuf_type_stats_t *gnrc_pktbuf_stats_type(
+    const gnrc_pktbuf_stats_t *stats, gnrc_nettype_t type)
+{
+    return &stats->types[type - GNRC_NETTYPE_IOVEC];
+}
+
+/**
+ * @brief   Calculates the fragmentation of the free space
+ *
+ * @param[in] stats     Statistics from gnrc_pktbuf_get_stats().
+ *
+ * @return  Percentage of the free space that is not part of the largest
+ *          free hole, 0 if the packet buffer is full or unbounded.
+ */
+static inline unsigned gnrc_pktbuf_stats_frag(const gnrc_pktbuf_stats_t *stats)
+{
+    size_t free = stats->size - stats->used;
+
+    if ((stats->size == 0) || (free == 0)) {
+        return 0;
+    }
+    return 100 - (unsigned)((stats->largest_free * 100) / free);
+}
+#endif
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
@@ -455,6 +455,43 @@ typedef enum {
      */
     NETOPT_TX_RETRIES_NEEDED,
 
+    /**
+     * @brief   (@ref netopt_enable_t) Verify transport layer checksums of
+     *          received frames in the device
+     *
+     * When enabled, the device has verified the checksum of every UDP, TCP
+     * and ICMPv6 message directly following the IPv6 header of a frame it
+     * passes up, and the network stack may skip verifying it again.
+     *
+     * Disabled by default, as the device may pass up messages whose checksum
+     * field holds only a partial checksum, e.g. the sum over the IPv6
+     * pseudo-header.  A network stack that does not look at the checksum of
+     * such messages again enables it.
+     */
+    NETOPT_RX_CHECKSUM_OFFLOAD,
+
+    /**
+     * @brief   (@ref netopt_enable_t) Complete transport layer checksums of
+     *          frames to send in the device
+     *
+     * When enabled, the network stack may put just the sum over the IPv6
+     * pseudo-header into the checksum field of a UDP, TCP or ICMPv6 message
+     * directly following the IPv6 header and leave the rest of the
+     * computation to the device.  Messages with a complete checksum are sent
+     * as they are.
+     */
+    NETOPT_TX_CHECKSUM_OFFLOAD,
+
+    /**
+     * @brief   (uint16_t) Maximum number of frames the interface handles per
+     *          wakeup before it lets other work in
+     *
+     * Only available with @ref net_gnrc_netif "gnrc_netif_poll": after an
+     * RX interrupt, further interrupts are masked and the interface keeps
+     * polling the device for up to this many frames.
+     */
+    NETOPT_RX_BUDGET,
+
     /* add more options if needed */
 
     /**
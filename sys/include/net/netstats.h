@@ -51,6 +51,11 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+#if defined(MODULE_GNRC_NETIF_POLL) || defined(DOXYGEN)
+    uint32_t rx_wakeups;        /**< wakeups of the receiving thread, i.e.
+                                     rx_count / rx_wakeups frames were
+                                     handled per wakeup */
+#endif
 } netstats_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,148 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_trace Scheduler trace
+ * @ingroup     sys
+ * @brief       Records kernel events into an in-RAM ring buffer
+ *
+ * When the module `sched_trace` is used, context switches, interrupt entry
+ * and exit, message send/receive and mutex block/unblock events are recorded
+ * as compact 8 byte records, each carrying an xtimer timestamp.  Recording
+ * is lock-free: a slot is reserved with a single atomic increment, so events
+ * can be recorded from thread and interrupt context alike.  When the ring is
+ * full, the oldest records are overwritten.
+ *
+ * The trace is controlled with @ref sched_trace_start and
+ * @ref sched_trace_stop (or the shell command `trace`), and printed with
+ * @ref sched_trace_dump.  `dist/tools/sched_trace/sched_trace2json.py`
+ * converts a dump into a Chrome trace (`chrome://tracing`) timeline.
+ *
+ * Interrupt entry and exit are recorded by the native CPU only.  Other CPUs
+ * can record them by calling @ref SCHED_TRACE with @ref SCHED_TRACE_IRQ_ENTER
+ * and @ref SCHED_TRACE_IRQ_EXIT from their interrupt dispatch code.
+ *
+ * Without the module, the @ref SCHED_TRACE hooks compile to nothing.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Scheduler trace interface
+ */
+
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of records in the trace ring, must be a power of two
+ */
+#ifndef SCHED_TRACE_SIZE
+#define SCHED_TRACE_SIZE            (256U)
+#endif
+
+#if (SCHED_TRACE_SIZE & (SCHED_TRACE_SIZE - 1)) != 0
+#error "SCHED_TRACE_SIZE must be a power of two"
+#endif
+
+/**
+ * @name    Trace event types
+ * @{
+ */
+#define SCHED_TRACE_SWITCH          (0U)    /**< context switch, pid = next thread,
+                                                 arg = previous thread */
+#define SCHED_TRACE_IRQ_ENTER       (1U)    /**< interrupt entry, arg = irq number */
+#define SCHED_TRACE_IRQ_EXIT        (2U)    /**< interrupt exit, arg = irq number */
+#define SCHED_TRACE_MSG_SEND        (3U)    /**< message sent, pid = target,
+                                                 arg = message type */
+#define SCHED_TRACE_MSG_RECEIVE     (4U)    /**< message received, pid = receiver,
+                                                 arg = message type */
+#define SCHED_TRACE_MUTEX_BLOCK     (5U)    /**< thread blocked on mutex, pid = thread,
+                                                 arg = low 16 bits of mutex address */
+#define SCHED_TRACE_MUTEX_UNBLOCK   (6U)    /**< thread woken by mutex unlock, pid = thread,
+                                                 arg = low 16 bits of mutex address */
+/** @} */
+
+/**
+ * @brief   A single trace record
+ */
+typedef struct {
+    uint32_t time;      /**< xtimer timestamp in ticks */
+    uint8_t event;      /**< event type, one of SCHED_TRACE_* */
+    uint8_t pid;        /**< thread the event refers to */
+    uint16_t arg;       /**< event specific argument */
+} sched_trace_entry_t;
+
+#if defined(MODULE_SCHED_TRACE) || defined(DOXYGEN)
+/**
+ * @brief   Record an event if tracing is enabled
+ *
+ * Safe to call from interrupt context.
+ *
+ * @param[in] event     event type
+ * @param[in] pid       thread the event refers to
+ * @param[in] arg       event specific argument
+ */
+void sched_trace_record(uint8_t event, kernel_pid_t pid, uint16_t arg);
+
+/**
+ * @brief   Start (or resume) recording events
+ */
+void sched_trace_start(void);
+
+/**
+ * @brief   Stop recording events
+ */
+void sched_trace_stop(void);
+
+/**
+ * @brief   Discard all recorded events
+ */
+void sched_trace_clear(void);
+
+/**
+ * @brief   Copy the recorded events, oldest first
+ *
+ * Tracing should be stopped while reading, otherwise records may be
+ * overwritten while they are being copied.
+ *
+ * @param[out] buf      buffer to copy the records to
+ * @param[in] max       maximum number of records to copy
+ *
+ * @return  number of records copied
+ */
+unsigned sched_trace_read(sched_trace_entry_t *buf, unsigned max);
+
+/**
+ * @brief   Print the recorded events to stdout
+ *
+ * Tracing is stopped for the duration of the dump.  The output format is
+ * understood by `dist/tools/sched_trace/sched_trace2json.py`.
+ */
+void sched_trace_dump(void);
+
+/**
+ * @brief   Hook used by the kernel to record an event
+ */
+#define SCHED_TRACE(event, pid, arg) \
+    sched_trace_record((event), (pid), (uint16_t)(arg))
+#else
+#define SCHED_TRACE(event, pid, arg)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_TRACE_H */
+/** @} */
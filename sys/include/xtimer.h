@@ -20,6 +20,12 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * If the pseudo-module `xtimer_wheel` is used, the sorted lists are replaced
+ * by a hierarchical timing wheel (see @ref XTIMER_WHEEL_LEVELS).  Insertion
+ * and removal then take constant time, at the cost of some RAM for the wheel
+ * slots and occasional extra low-level timer interrupts for cascading timers
+ * from coarser to finer wheel levels.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -74,8 +80,30 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer **pprev;       /**< reference to the pointer pointing to
+                                     this timer (timing wheel backend only) */
+    uintptr_t link_check;        /**< validates xtimer::pprev of timers that
+                                     may never have been set (timing wheel
+                                     backend only) */
+#endif
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+    uint32_t slack;              /**< ticks the timer may expire late
+                                     (module `xtimer_slack` only) */
+#endif
 } xtimer_t;
 
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief xtimer wakeup statistics (module `xtimer_slack` only)
+ */
+typedef struct {
+    uint32_t wakeups;   /**< timer interrupts that expired at least one timer */
+    uint32_t merged;    /**< timer expirations that were handled by the
+                             interrupt of another timer */
+} xtimer_stats_t;
+#endif
+
 /**
  * @brief get the current system time as 32bit time stamp value
  *
@@ -291,6 +319,51 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer that may expire late by up to @p slack microseconds
+ *
+ * Like xtimer_set(), but the callback may be executed anywhere between
+ * @p offset and @p offset + @p slack microseconds from now. With module
+ * `xtimer_slack`, xtimer uses that tolerance to let timers whose windows
+ * overlap expire in a single interrupt. Without it, @p slack is ignored.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    minimum time in microseconds from now until the
+ *                      callback is executed
+ * @param[in] slack     time in microseconds the callback may be delayed
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack);
+
+/**
+ * @brief Set a timer that sends a message and may expire late by up to
+ *        @p slack microseconds
+ *
+ * See xtimer_set_slack() and xtimer_set_msg().
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use.
+ * @param[in] offset        minimum time in microseconds from now until the
+ *                          message is sent
+ * @param[in] slack         time in microseconds the message may be delayed
+ * @param[in] msg           ptr to msg that will be sent
+ * @param[in] target_pid    pid the message will be sent to
+ */
+static inline void xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset,
+                                        uint32_t slack, msg_t *msg,
+                                        kernel_pid_t target_pid);
+
+#if defined(MODULE_XTIMER_SLACK) || defined(DOXYGEN)
+/**
+ * @brief Get the timer wakeup statistics (module `xtimer_slack` only)
+ *
+ * @param[out] stats    the statistics are written here
+ */
+void xtimer_get_stats(xtimer_stats_t *stats);
+#endif
+
 /**
  * @brief remove a timer
  *
@@ -520,6 +593,29 @@ void xtimer_set_timeout_flag(xtimer_t *t, uint32_t timeout);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#ifndef XTIMER_WHEEL_LEVEL_BITS
+/**
+ * @brief   Number of bits of the timer target resolved by each level of the
+ *          timing wheel (module `xtimer_wheel` only)
+ *
+ * Each level has 2^XTIMER_WHEEL_LEVEL_BITS slots. This must not exceed the
+ * number of bits in an `unsigned int`.
+ */
+#define XTIMER_WHEEL_LEVEL_BITS (4)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the timing wheel (module `xtimer_wheel` only)
+ *
+ * The wheel covers 2^(XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_LEVEL_BITS) ticks.
+ * Timers further in the future are kept in a separate list that is
+ * redistributed once per wheel revolution.
+ * XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_LEVEL_BITS must be between 16 and 32.
+ */
+#define XTIMER_WHEEL_LEVELS     (8)
+#endif
+
 /*
  * Default xtimer configuration
  */
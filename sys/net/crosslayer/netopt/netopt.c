@@ -87,6 +87,9 @@ static const char *_netopt_strmap[] = {
     [NETOPT_IQ_INVERT]             = "NETOPT_IQ_INVERT",
     [NETOPT_TX_RETRIES_NEEDED]     = "NETOPT_TX_RETRIES_NEEDED",
     [NETOPT_6LO_IPHC]              = "NETOPT_6LO_IPHC",
+    [NETOPT_RX_CHECKSUM_OFFLOAD]   = "NETOPT_RX_CHECKSUM_OFFLOAD",
+    [NETOPT_TX_CHECKSUM_OFFLOAD]   = "NETOPT_TX_CHECKSUM_OFFLOAD",
+    [NETOPT_RX_BUDGET]             = "NETOPT_RX_BUDGET",
     [NETOPT_NUMOF]                 = "NETOPT_NUMOF",
 };
 
@@ -91,55 +91,134 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
-int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
-                         uint16_t cmd, gnrc_pktsnip_t *pkt)
+static inline int _snd_rcv_bulk(kernel_pid_t pid, uint16_t type,
+                                gnrc_pktsnip_t **pkts, unsigned num)
 {
-    int numof = gnrc_netreg_num(type, demux_ctx);
-
-    if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+    msg_t msgs[GNRC_NETAPI_BULK_SIZE];
+    unsigned sent = 0;
 
-        gnrc_pktbuf_hold(pkt, numof - 1);
+    while (sent < num) {
+        unsigned chunk = num - sent;
+        if (chunk > GNRC_NETAPI_BULK_SIZE) {
+            chunk = GNRC_NETAPI_BULK_SIZE;
+        }
+        /* set the outgoing messages' fields */
+        for (unsigned i = 0; i < chunk; i++) {
+            msgs[i].type = type;
+            msgs[i].content.ptr = (void *)pkts[sent + i];
+        }
+        /* send messages */
+        int ret = msg_send_bulk(msgs, chunk, pid);
+        if (ret > 0) {
+            sent += ret;
+        }
+        if (ret < (int)chunk) {
+            DEBUG("gnrc_netapi: dropped %u messages to %" PRIkernel_pid " (%s)\n",
+                  num - sent, pid,
+                  (ret < 0) ? "invalid receiver" : "receiver queue is full");
+            break;
+        }
+    }
+    return sent;
+}
 
-        while (sendto) {
+/**
+ * @brief   Dispatch a single packet to one subscriber
+ */
+static void _dispatch(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                      gnrc_pktsnip_t *pkt)
+{
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            int release = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
+    int release = 0;
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+            if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                release = 1;
+            }
+            break;
 #ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
+        case GNRC_NETREG_TYPE_MBOX:
+            if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                release = 1;
+            }
+            break;
 #endif
 #ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            break;
 #endif
-                default:
-                    /* unknown dispatch type */
-                    release = 1;
-                    break;
-            }
-            if (release) {
-                gnrc_pktbuf_release(pkt);
-            }
+        default:
+            /* unknown dispatch type */
+            release = 1;
+            break;
+    }
+    if (release) {
+        gnrc_pktbuf_release(pkt);
+    }
 #else
-            if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release(pkt);
+    if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
+        /* unable to dispatch packet */
+        gnrc_pktbuf_release(pkt);
+    }
+#endif
+}
+
+int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
+                         uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    int numof = 0;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+
+    /* single pass: hold the packet for every further subscriber before it
+     * is handed to the current one, which may release it right away */
+    while (sendto) {
+        gnrc_netreg_entry_t *next = gnrc_netreg_getnext(sendto);
+
+        if (next != NULL) {
+            gnrc_pktbuf_hold(pkt, 1);
+        }
+        _dispatch(sendto, cmd, pkt);
+        numof++;
+        sendto = next;
+    }
+
+    return numof;
+}
+
+int gnrc_netapi_dispatch_bulk(gnrc_nettype_t type, uint32_t demux_ctx,
+                              uint16_t cmd, gnrc_pktsnip_t **pkts,
+                              unsigned num)
+{
+    int numof = 0;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+
+    while (sendto) {
+        gnrc_netreg_entry_t *next = gnrc_netreg_getnext(sendto);
+
+        if (next != NULL) {
+            for (unsigned i = 0; i < num; i++) {
+                gnrc_pktbuf_hold(pkts[i], 1);
             }
+        }
+        numof++;
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+        if (sendto->type != GNRC_NETREG_TYPE_DEFAULT) {
+            for (unsigned i = 0; i < num; i++) {
+                _dispatch(sendto, cmd, pkts[i]);
+            }
+            sendto = next;
+            continue;
+        }
 #endif
-            sendto = gnrc_netreg_getnext(sendto);
+        unsigned sent = _snd_rcv_bulk(sendto->target.pid, cmd, pkts, num);
+        /* release the packets that could not be dispatched */
+        for (unsigned i = sent; i < num; i++) {
+            gnrc_pktbuf_release(pkts[i]);
         }
+        sendto = next;
     }
 
     return numof;
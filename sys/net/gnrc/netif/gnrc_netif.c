@@ -19,6 +19,9 @@
 #include "net/ethernet.h"
 #include "net/ipv6.h"
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_IPV6_DCACHE
+#include "net/gnrc/ipv6/dcache.h"
+#endif /* MODULE_GNRC_IPV6_DCACHE */
 #ifdef MODULE_GNRC_IPV6_NIB
 #include "net/gnrc/ipv6/nib.h"
 #endif /* MODULE_GNRC_IPV6_NIB */
@@ -27,6 +30,9 @@
 #endif
 #include "log.h"
 #include "sched.h"
+#ifdef MODULE_GNRC_NETIF_POLL
+#include "irq.h"
+#endif
 
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/internal.h"
@@ -40,13 +46,22 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 #define _NETIF_NETAPI_MSG_QUEUE_SIZE    (8)
 
+#ifdef MODULE_GNRC_NETIF_POLL
+#define _RX_POLL_SCHEDULED              (0x01U) /**< RX events are masked */
+#define _RX_POLL_PENDING                (0x02U) /**< RX event while masked */
+#endif
+
 static gnrc_netif_t _netifs[GNRC_NETIF_NUMOF];
 
 static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+static void _isr(gnrc_netif_t *netif);
+#ifdef MODULE_GNRC_NETIF_POLL
+static void _rx_poll(gnrc_netif_t *netif);
+#endif
 
-gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
+gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, uint8_t priority,
                                 const char *name, netdev_t *netdev,
                                 const gnrc_netif_ops_t *ops)
 {
@@ -110,6 +125,13 @@ int gnrc_netif_get_from_netdev(gnrc_netif_t *netif, gnrc_netapi_opt_t *opt)
             *((uint8_t *)opt->data) = netif->cur_hl;
             res = sizeof(uint8_t);
             break;
+#ifdef MODULE_GNRC_NETIF_POLL
+        case NETOPT_RX_BUDGET:
+            assert(opt->data_len == sizeof(uint16_t));
+            *((uint16_t *)opt->data) = netif->rx_budget;
+            res = sizeof(uint16_t);
+            break;
+#endif
         case NETOPT_STATS:
             /* XXX discussed this with Oleg, it's supposed to be a pointer */
             switch ((int16_t)opt->context) {
@@ -233,6 +255,17 @@ int gnrc_netif_set_from_netdev(gnrc_netif_t *netif,
             netif->cur_hl = *((uint8_t *)opt->data);
             res = sizeof(uint8_t);
             break;
+#ifdef MODULE_GNRC_NETIF_POLL
+        case NETOPT_RX_BUDGET:
+            assert(opt->data_len == sizeof(uint16_t));
+            if (*((uint16_t *)opt->data) == 0) {
+                res = -EINVAL;
+                break;
+            }
+            netif->rx_budget = *((uint16_t *)opt->data);
+            res = sizeof(uint16_t);
+            break;
+#endif
 #ifdef MODULE_GNRC_IPV6
         case NETOPT_IPV6_ADDR: {
                 assert(opt->data_len == sizeof(ipv6_addr_t));
@@ -559,6 +592,10 @@ int gnrc_netif_ipv6_addr_add_internal(gnrc_netif_t *netif,
     }
     netif->ipv6.addrs_flags[idx] = flags;
     memcpy(&netif->ipv6.addrs[idx], addr, sizeof(netif->ipv6.addrs[idx]));
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    /* cached source addresses may not be the best anymore */
+    gnrc_ipv6_dcache_flush();
+#endif /* MODULE_GNRC_IPV6_DCACHE */
 #ifdef MODULE_GNRC_IPV6_NIB
 #if GNRC_IPV6_NIB_CONF_ARSM
     ipv6_addr_t sol_nodes;
@@ -633,6 +670,9 @@ void gnrc_netif_ipv6_addr_remove_internal(gnrc_netif_t *netif,
     if (remove_sol_nodes) {
         gnrc_netif_ipv6_group_leave_internal(netif, &sol_nodes);
     }
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    gnrc_ipv6_dcache_flush();
+#endif /* MODULE_GNRC_IPV6_DCACHE */
     gnrc_netif_release(netif);
 }
 
@@ -1154,6 +1194,40 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     }
 }
 
+#ifdef MODULE_GNRC_IPV6
+bool gnrc_netif_ipv6_rx_csum_offloaded(const gnrc_pktsnip_t *ipv6,
+                                       uint8_t protnum)
+{
+    gnrc_pktsnip_t *netif_hdr = ipv6->next;
+    gnrc_netif_t *netif;
+
+    /* an IPv6 header not directly received from the interface (e.g.
+     * encapsulated) was not looked at by the device */
+    if ((netif_hdr == NULL) || (netif_hdr->type != GNRC_NETTYPE_NETIF) ||
+        (((ipv6_hdr_t *)ipv6->data)->nh != protnum)) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid);
+    return (netif != NULL) && (netif->flags & GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD);
+}
+
+static void _init_csum_offload(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    const netopt_enable_t enable = NETOPT_ENABLE;
+
+    /* GNRC checks for the offload per packet, so it can make use of it */
+    if (dev->driver->set(dev, NETOPT_RX_CHECKSUM_OFFLOAD, &enable,
+                         sizeof(enable)) >= 0) {
+        netif->flags |= GNRC_NETIF_FLAGS_RX_CSUM_OFFLOAD;
+    }
+    if (dev->driver->set(dev, NETOPT_TX_CHECKSUM_OFFLOAD, &enable,
+                         sizeof(enable)) >= 0) {
+        netif->flags |= GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD;
+    }
+}
+#endif  /* MODULE_GNRC_IPV6 */
+
 static void _init_from_device(gnrc_netif_t *netif)
 {
     int res;
@@ -1202,6 +1276,9 @@ static void _init_from_device(gnrc_netif_t *netif)
 #endif
             break;
     }
+#ifdef MODULE_GNRC_IPV6
+    _init_csum_offload(netif);
+#endif
     _update_l2addr_from_dev(netif);
 }
 
@@ -1221,6 +1298,13 @@ static void *_gnrc_netif_thread(void *args)
     netif->pid = sched_active_pid;
     /* setup the link-layer's message queue */
     msg_init_queue(msg_queue, _NETIF_NETAPI_MSG_QUEUE_SIZE);
+#ifdef MODULE_GNRC_NETIF_POLL
+    netif->rx_budget = GNRC_NETIF_RX_BUDGET;
+    netif->rx_poll = 0;
+#endif
+#ifdef MODULE_GNRC_NETIF_BULK
+    netif->rx_pkts_num = 0;
+#endif
     /* register the event callback with the device driver */
     dev->event_callback = _event_cb;
     dev->context = netif;
@@ -1234,6 +1318,10 @@ static void *_gnrc_netif_thread(void *args)
     if (netif->ops->init) {
         netif->ops->init(netif);
     }
+#ifdef MODULE_GNRC_NETIF_TXQ
+    /* MAC layers that take over the device events also queue themselves */
+    gnrc_netif_txq_init(netif, (dev->event_callback == _event_cb));
+#endif
     /* now let rest of GNRC use the interface */
     gnrc_netif_release(netif);
 
@@ -1244,16 +1332,24 @@ static void *_gnrc_netif_thread(void *args)
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr(dev);
+#ifdef MODULE_GNRC_NETIF_POLL
+                _rx_poll(netif);
+#else
+                _isr(netif);
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
+#ifdef MODULE_GNRC_NETIF_TXQ
+                gnrc_netif_txq_send(netif, msg.content.ptr);
+#else
                 res = netif->ops->send(netif, msg.content.ptr);
 #if ENABLE_DEBUG
                 if (res < 0) {
                     DEBUG("gnrc_netif: error sending packet %p (code: %u)\n",
                           msg.content.ptr, res);
                 }
+#endif
 #endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_SET:
@@ -1268,8 +1364,21 @@ static void *_gnrc_netif_thread(void *args)
                 /* set option for device driver */
                 res = netif->ops->set(netif, opt);
                 DEBUG("gnrc_netif: response of netif->ops->set(): %i\n", res);
+#ifdef MODULE_GNRC_NETIF_TXQ
+                /* the device does not report the end of a transmission it
+                 * aborts due to a state change (e.g. a reset); opt is
+                 * invalid after the reply */
+                bool txq_reset = (res >= 0) && (opt->opt == NETOPT_STATE) &&
+                                 (*((netopt_state_t *)opt->data) !=
+                                  NETOPT_STATE_TX);
+#endif
                 reply.content.value = (uint32_t)res;
                 msg_reply(&msg, &reply);
+#ifdef MODULE_GNRC_NETIF_TXQ
+                if (txq_reset) {
+                    gnrc_netif_txq_reset(netif);
+                }
+#endif
                 break;
             case GNRC_NETAPI_MSG_TYPE_GET:
                 opt = msg.content.ptr;
@@ -1286,6 +1395,12 @@ static void *_gnrc_netif_thread(void *args)
                 reply.content.value = (uint32_t)res;
                 msg_reply(&msg, &reply);
                 break;
+#ifdef MODULE_GNRC_NETIF_TXQ
+            case GNRC_NETIF_TXQ_MSG_TYPE_TIMEOUT:
+                DEBUG("gnrc_netif: GNRC_NETIF_TXQ_MSG_TYPE_TIMEOUT received\n");
+                gnrc_netif_txq_timeout(netif);
+                break;
+#endif
             default:
                 if (netif->ops->msg_handler) {
                     DEBUG("gnrc_netif: delegate message of type 0x%04x to "
@@ -1305,14 +1420,95 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+#ifdef MODULE_GNRC_NETIF_POLL
+static void _rx_poll(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    unsigned state;
+    bool pending;
+
+#ifdef MODULE_NETSTATS_L2
+    dev->stats.rx_wakeups++;
+#endif
+    netif->rx_frames = 0;
+    do {
+        state = irq_disable();
+        netif->rx_poll &= ~_RX_POLL_PENDING;
+        irq_restore(state);
+        _isr(netif);
+        state = irq_disable();
+        pending = (netif->rx_poll & _RX_POLL_PENDING);
+        if (!pending) {
+            /* no new frame arrived in the meantime: unmask RX events */
+            netif->rx_poll = 0;
+        }
+        irq_restore(state);
+    } while (pending && (netif->rx_frames < netif->rx_budget));
+
+    if (pending) {
+        /* budget exhausted: handle the messages queued up in the meantime
+         * first, RX events stay masked */
+        msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
+                      .content = { .ptr = netif } };
+
+        if (msg_send_to_self(&msg) <= 0) {
+            netif->rx_poll = 0;
+            puts("gnrc_netif: possibly lost interrupt.");
+        }
+    }
+}
+#endif
+
+#ifdef MODULE_GNRC_NETIF_BULK
+static void _flush_rx(gnrc_netif_t *netif)
+{
+    unsigned num = netif->rx_pkts_num;
+
+    if (num == 0) {
+        return;
+    }
+    netif->rx_pkts_num = 0;
+    /* throw away packets if no one is interested */
+    if (!gnrc_netapi_dispatch_bulk(netif->rx_pkts[0]->type,
+                                   GNRC_NETREG_DEMUX_CTX_ALL,
+                                   GNRC_NETAPI_MSG_TYPE_RCV,
+                                   netif->rx_pkts, num)) {
+        DEBUG("gnrc_netif: unable to forward %u packets of type %i\n", num,
+              netif->rx_pkts[0]->type);
+        for (unsigned i = 0; i < num; i++) {
+            gnrc_pktbuf_release(netif->rx_pkts[i]);
+        }
+    }
+}
+#endif
+
+static void _isr(gnrc_netif_t *netif)
+{
+    netif->dev->driver->isr(netif->dev);
+#ifdef MODULE_GNRC_NETIF_BULK
+    /* pass on the packets received in this call in one go */
+    _flush_rx(netif);
+#endif
+}
+
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
+#ifdef MODULE_GNRC_NETIF_BULK
+    /* a bulk only holds packets of the same type */
+    if ((netif->rx_pkts_num == GNRC_NETAPI_BULK_SIZE) ||
+        ((netif->rx_pkts_num > 0) && (netif->rx_pkts[0]->type != pkt->type))) {
+        _flush_rx(netif);
+    }
+    netif->rx_pkts[netif->rx_pkts_num++] = pkt;
+#else
+    (void)netif;
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("gnrc_netif: unable to forward packet of type %i\n", pkt->type);
         gnrc_pktbuf_release(pkt);
         return;
     }
+#endif
 }
 
 static void _event_cb(netdev_t *dev, netdev_event_t event)
@@ -1323,7 +1519,18 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
         msg_t msg = { .type = NETDEV_MSG_TYPE_EVENT,
                       .content = { .ptr = netif } };
 
+#ifdef MODULE_GNRC_NETIF_POLL
+        if (netif->rx_poll & _RX_POLL_SCHEDULED) {
+            /* thread is already polling the device, it will pick this up */
+            netif->rx_poll |= _RX_POLL_PENDING;
+            return;
+        }
+        netif->rx_poll = _RX_POLL_SCHEDULED;
+#endif
         if (msg_send(&msg, netif->pid) <= 0) {
+#ifdef MODULE_GNRC_NETIF_POLL
+            netif->rx_poll = 0;
+#endif
             puts("gnrc_netif: possibly lost interrupt.");
         }
     }
@@ -1333,21 +1540,39 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE: {
                     gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
 
+#ifdef MODULE_GNRC_NETIF_POLL
+                    netif->rx_frames++;
+#endif
                     if (pkt) {
-                        _pass_on_packet(pkt);
+                        _pass_on_packet(netif, pkt);
                     }
                 }
                 break;
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_GNRC_NETIF_TXQ)
             case NETDEV_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 /* we are the only ones supposed to touch this variable,
                  * so no acquire necessary */
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_GNRC_NETIF_TXQ
+                gnrc_netif_txq_tx_done(netif);
+#endif
                 break;
             case NETDEV_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 /* we are the only ones supposed to touch this variable,
                  * so no acquire necessary */
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_GNRC_NETIF_TXQ
+                gnrc_netif_txq_tx_done(netif);
+#endif
+                break;
+#endif
+#ifdef MODULE_GNRC_NETIF_TXQ
+            case NETDEV_EVENT_TX_NOACK:
+                gnrc_netif_txq_tx_done(netif);
                 break;
 #endif
             default:
@@ -41,7 +41,7 @@ static const gnrc_netif_ops_t ethernet_ops = {
 };
 
 gnrc_netif_t *gnrc_netif_ethernet_create(char *stack, int stacksize,
-                                         char priority, char *name,
+                                         uint8_t priority, char *name,
                                          netdev_t *dev)
 {
     return gnrc_netif_create(stack, stacksize, priority, name, dev,
@@ -40,7 +40,7 @@ static const gnrc_netif_ops_t ieee802154_ops = {
 };
 
 gnrc_netif_t *gnrc_netif_ieee802154_create(char *stack, int stacksize,
-                                           char priority, char *name,
+                                           uint8_t priority, char *name,
                                            netdev_t *dev)
 {
     return gnrc_netif_create(stack, stacksize, priority, name, dev,
@@ -0,0 +1,242 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_netif_txq
+ * @{
+ *
+ * @file
+ */
+
+#ifdef MODULE_GNRC_NETIF_TXQ
+
+#include "net/gnrc.h"
+#include "net/gnrc/netif/internal.h"
+#ifdef MODULE_GNRC_IPV6
+#include "net/ipv6/hdr.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _ASYNC          (0x01U) /**< device signals the end of a transmission */
+#define _BUSY           (0x02U) /**< a transmission is in progress */
+#define _IN_SEND        (0x04U) /**< netif->ops->send() is running */
+
+#define _DSCP_CS1       (8U)
+#define _DSCP_CS6       (48U)
+#define _ECN_CE         (3U)
+
+static gnrc_netif_txq_prio_t _classify(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_ICMPV6
+    if (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMPV6) != NULL) {
+        return GNRC_NETIF_TXQ_PRIO_CTRL;
+    }
+#endif
+#ifdef MODULE_GNRC_IPV6
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+
+    if ((ipv6 != NULL) && (ipv6->size >= sizeof(ipv6_hdr_t))) {
+        uint8_t dscp = ipv6_hdr_get_tc_dscp(ipv6->data);
+
+        if (dscp >= _DSCP_CS6) {
+            return GNRC_NETIF_TXQ_PRIO_CTRL;
+        }
+        if (dscp == _DSCP_CS1) {
+            return GNRC_NETIF_TXQ_PRIO_BULK;
+        }
+    }
+#else
+    (void)pkt;
+#endif
+    return GNRC_NETIF_TXQ_PRIO_DATA;
+}
+
+static bool _mark_ce(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_IPV6
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+
+    /* compressed headers (6LoWPAN) can't be marked anymore and a shared
+     * header would be marked for other interfaces as well */
+    if ((ipv6 != NULL) && (ipv6->size >= sizeof(ipv6_hdr_t)) &&
+        (pkt->users == 1) && (ipv6->users == 1)) {
+        ipv6_hdr_t *hdr = ipv6->data;
+        uint8_t ecn = ipv6_hdr_get_tc_ecn(hdr);
+
+        /* only ECT(0) and ECT(1) may be marked */
+        if ((ecn != 0) && (ecn != _ECN_CE)) {
+            ipv6_hdr_set_tc_ecn(hdr, _ECN_CE);
+            return true;
+        }
+    }
+#else
+    (void)pkt;
+#endif
+    return false;
+}
+
+static gnrc_priority_pktqueue_node_t *_alloc_node(gnrc_netif_txq_t *txq)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_TXQ_SIZE; i++) {
+        if ((txq->nodes[i].pkt == NULL) && (txq->nodes[i].next == NULL)) {
+            return &txq->nodes[i];
+        }
+    }
+    return NULL;
+}
+
+/* drops the newest packet of the lowest class, if lower than prio, and
+ * returns its node */
+static gnrc_priority_pktqueue_node_t *_evict(gnrc_netif_txq_t *txq,
+                                             uint32_t prio)
+{
+    priority_queue_node_t *prev = (priority_queue_node_t *)&txq->queue;
+    gnrc_priority_pktqueue_node_t *last;
+
+    while (prev->next->next != NULL) {
+        prev = prev->next;
+    }
+    last = (gnrc_priority_pktqueue_node_t *)prev->next;
+    if (last->priority <= prio) {
+        return NULL;
+    }
+    DEBUG("gnrc_netif_txq: dropping queued packet %p of class %u\n",
+          (void *)last->pkt, (unsigned)last->priority);
+    prev->next = NULL;
+    gnrc_pktbuf_release(last->pkt);
+    txq->stats.dropped++;
+    txq->len--;
+    return last;
+}
+
+static void _enqueue(gnrc_netif_txq_t *txq, gnrc_pktsnip_t *pkt)
+{
+    uint32_t prio = _classify(pkt);
+    gnrc_priority_pktqueue_node_t *node = _alloc_node(txq);
+
+    if ((node == NULL) && ((node = _evict(txq, prio)) == NULL)) {
+        DEBUG("gnrc_netif_txq: queue full, dropping packet %p\n", (void *)pkt);
+        txq->stats.dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((txq->len >= GNRC_NETIF_TXQ_ECN_THRESHOLD) && _mark_ce(pkt)) {
+        txq->stats.marked++;
+    }
+    gnrc_priority_pktqueue_node_init(node, prio, pkt);
+    gnrc_priority_pktqueue_push(&txq->queue, node);
+    txq->stats.queued++;
+    if (++txq->len > txq->stats.max_len) {
+        txq->stats.max_len = txq->len;
+    }
+}
+
+static void _transmit(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    int res;
+
+    netif->txq.flags |= _BUSY | _IN_SEND;
+    netif->txq.tx_start = xtimer_now_usec();
+    res = netif->ops->send(netif, pkt);
+    netif->txq.flags &= ~_IN_SEND;
+    if (res < 0) {
+        /* the device won't report the end of a transmission it never
+         * started */
+        DEBUG("gnrc_netif_txq: error sending packet %p (code: %i)\n",
+              (void *)pkt, res);
+        netif->txq.flags &= ~_BUSY;
+    }
+    else if (netif->txq.flags & _BUSY) {
+        xtimer_set_msg(&netif->txq.timer, GNRC_NETIF_TXQ_TX_TIMEOUT,
+                       &netif->txq.timeout_msg, netif->pid);
+    }
+}
+
+static void _drain(gnrc_netif_t *netif)
+{
+    while (!(netif->txq.flags & _BUSY) && (netif->txq.len > 0)) {
+        gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&netif->txq.queue);
+
+        netif->txq.len--;
+        _transmit(netif, pkt);
+    }
+}
+
+void gnrc_netif_txq_init(gnrc_netif_t *netif, bool async)
+{
+    netopt_enable_t enable = NETOPT_ENABLE;
+
+    gnrc_priority_pktqueue_init(&netif->txq.queue);
+    netif->txq.len = 0;
+    netif->txq.flags = 0;
+    netif->txq.timeout_msg.type = GNRC_NETIF_TXQ_MSG_TYPE_TIMEOUT;
+    if (async &&
+        (netif->dev->driver->set(netif->dev, NETOPT_TX_END_IRQ, &enable,
+                                 sizeof(enable)) >= 0)) {
+        netif->txq.flags |= _ASYNC;
+    }
+    DEBUG("gnrc_netif_txq: queueing %s for interface %i\n",
+          (netif->txq.flags & _ASYNC) ? "enabled" : "disabled", netif->pid);
+}
+
+void gnrc_netif_txq_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    if (!(netif->txq.flags & _ASYNC)) {
+        int res = netif->ops->send(netif, pkt);
+
+        if (res < 0) {
+            DEBUG("gnrc_netif_txq: error sending packet %p (code: %i)\n",
+                  (void *)pkt, res);
+        }
+        return;
+    }
+    if (netif->txq.flags & _BUSY) {
+        _enqueue(&netif->txq, pkt);
+        return;
+    }
+    _transmit(netif, pkt);
+}
+
+void gnrc_netif_txq_tx_done(gnrc_netif_t *netif)
+{
+    xtimer_remove(&netif->txq.timer);
+    netif->txq.flags &= ~_BUSY;
+    /* some devices report the end of a transmission from within their send
+     * function already; the queue is drained once that returns */
+    if (!(netif->txq.flags & _IN_SEND)) {
+        _drain(netif);
+    }
+}
+
+void gnrc_netif_txq_reset(gnrc_netif_t *netif)
+{
+    xtimer_remove(&netif->txq.timer);
+    netif->txq.flags &= ~_BUSY;
+    _drain(netif);
+}
+
+void gnrc_netif_txq_timeout(gnrc_netif_t *netif)
+{
+    /* the message may stem from a transmission that ended while it was
+     * already queued */
+    if (!(netif->txq.flags & _BUSY) ||
+        ((xtimer_now_usec() - netif->txq.tx_start) <
+         GNRC_NETIF_TXQ_TX_TIMEOUT)) {
+        return;
+    }
+    DEBUG("gnrc_netif_txq: transmission timed out on interface %i\n",
+          netif->pid);
+    netif->txq.stats.timeouts++;
+    gnrc_netif_txq_reset(netif);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_NETIF_TXQ */
+
+/** @} */
@@ -27,13 +27,36 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#if (GNRC_NETREG_HASH_SIZE & (GNRC_NETREG_HASH_SIZE - 1)) || (GNRC_NETREG_HASH_SIZE > 256)
+#error "GNRC_NETREG_HASH_SIZE must be a power of 2 <= 256"
+#endif
+
+/* The registry as hash table by gnrc_nettype_t and demux context. Entries
+ * with the same demux context are consecutive in their bucket. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_HASH_SIZE];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* Fibonacci hashing: the upper bits of the product are mixed best */
+    return &netreg[type][((demux_ctx * 0x9e3779b1U) >> 24) &
+                         (GNRC_NETREG_HASH_SIZE - 1)];
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return &netreg[type];
+}
+#endif
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -53,7 +76,25 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    gnrc_netreg_entry_t **bucket = _bucket(type, entry->demux_ctx);
+    gnrc_netreg_entry_t *prev = NULL, *next = *bucket;
+
+    /* put the entry in front of the first one with the same demux context */
+    while ((next != NULL) && (next->demux_ctx != entry->demux_ctx)) {
+        prev = next;
+        next = next->next;
+    }
+    entry->next = next;
+    if (prev == NULL) {
+        *bucket = entry;
+    }
+    else {
+        prev->next = entry;
+    }
+#else
     LL_PREPEND(netreg[type], entry);
+#endif
 
     return 0;
 }
@@ -64,7 +105,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_bucket(type, entry->demux_ctx), entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -75,7 +116,7 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    LL_SEARCH_SCALAR(*_bucket(type, demux_ctx), res, demux_ctx, demux_ctx);
 
     return res;
 }
@@ -83,20 +124,11 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     int num = 0;
-    gnrc_netreg_entry_t *entry;
-
-    if (_INVALID_TYPE(type)) {
-        return 0;
-    }
-
-    entry = netreg[type];
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(type, demux_ctx);
 
     while (entry != NULL) {
-        if (entry->demux_ctx == demux_ctx) {
-            num++;
-        }
-
-        entry = entry->next;
+        num++;
+        entry = gnrc_netreg_getnext(entry);
     }
 
     return num;
@@ -112,9 +144,14 @@ gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 
     demux_ctx = entry->demux_ctx;
 
+#ifdef MODULE_GNRC_NETREG_HASH
+    entry = entry->next;
+    return ((entry != NULL) && (entry->demux_ctx == demux_ctx)) ? entry : NULL;
+#else
     LL_SEARCH_SCALAR(entry->next, entry, demux_ctx, demux_ctx);
 
     return entry;
+#endif
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
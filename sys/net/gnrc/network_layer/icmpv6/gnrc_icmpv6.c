@@ -24,6 +24,7 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/internal.h"
 #include "net/protnum.h"
 #include "od.h"
 #include "utlist.h"
@@ -77,7 +78,8 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
     hdr = (icmpv6_hdr_t *)icmpv6->data;
 
-    if (_calc_csum(icmpv6, ipv6, pkt)) {
+    if (!gnrc_netif_ipv6_rx_csum_offloaded(ipv6, PROTNUM_ICMPV6) &&
+        _calc_csum(icmpv6, ipv6, pkt)) {
         DEBUG("icmpv6: wrong checksum.\n");
         /* don't release: IPv6 does this */
         return;
@@ -0,0 +1,138 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_ipv6_dcache
+ * @{
+ *
+ * @file
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "net/gnrc/ipv6/dcache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_IPV6_DCACHE_SIZE & (GNRC_IPV6_DCACHE_SIZE - 1)) != 0
+#error "GNRC_IPV6_DCACHE_SIZE must be a power of 2"
+#endif
+
+static gnrc_ipv6_dcache_entry_t _entries[GNRC_IPV6_DCACHE_SIZE];
+static gnrc_ipv6_dcache_stats_t _stats;
+/* entries of another generation are invalid, 0 is never used so zeroed
+ * entries are invalid from the start */
+static volatile uint32_t _gen = 1;
+/* generation at the last miss */
+static uint32_t _miss_gen;
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+static inline unsigned _idx(const ipv6_addr_t *dst, kernel_pid_t iface)
+{
+    uint32_t hash = dst->u32[0].u32 ^ dst->u32[1].u32 ^ dst->u32[2].u32 ^
+                    dst->u32[3].u32 ^ (uint32_t)iface;
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (GNRC_IPV6_DCACHE_SIZE - 1);
+}
+
+gnrc_ipv6_dcache_entry_t *gnrc_ipv6_dcache_get(const ipv6_addr_t *dst,
+                                               kernel_pid_t iface)
+{
+    gnrc_ipv6_dcache_entry_t *entry = &_entries[_idx(dst, iface)];
+    uint32_t gen = _gen;
+
+    if ((entry->gen == gen) && (entry->iface == iface) &&
+        ipv6_addr_equal(&entry->dst, dst)) {
+        _stats.hits++;
+        return entry;
+    }
+    _stats.misses++;
+    _miss_gen = gen;
+    return NULL;
+}
+
+gnrc_ipv6_dcache_entry_t *gnrc_ipv6_dcache_add(const ipv6_addr_t *dst,
+                                               kernel_pid_t iface,
+                                               gnrc_netif_t *netif,
+                                               const gnrc_ipv6_nib_nc_t *nce)
+{
+    gnrc_ipv6_dcache_entry_t *entry = &_entries[_idx(dst, iface)];
+
+    if (_miss_gen != _gen) {
+        DEBUG("ipv6 dcache: flushed during lookup, not adding %s\n",
+              ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        return NULL;
+    }
+    DEBUG("ipv6 dcache: add %s\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    memcpy(&entry->dst, dst, sizeof(entry->dst));
+    memcpy(&entry->next_hop, &nce->ipv6, sizeof(entry->next_hop));
+    ipv6_addr_set_unspecified(&entry->src);
+    entry->netif = netif;
+    entry->iface = iface;
+    memcpy(entry->l2addr, nce->l2addr, nce->l2addr_len);
+    entry->l2addr_len = nce->l2addr_len;
+    entry->gen = _miss_gen;
+    return entry;
+}
+
+void gnrc_ipv6_dcache_flush(void)
+{
+    unsigned state = irq_disable();
+
+    if (++_gen == 0) {
+        _gen = 1;
+    }
+    _stats.flushes++;
+    irq_restore(state);
+}
+
+void gnrc_ipv6_dcache_get_stats(gnrc_ipv6_dcache_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    memcpy(stats, &_stats, sizeof(_stats));
+    irq_restore(state);
+}
+
+void gnrc_ipv6_dcache_print(void)
+{
+    char str[(IPV6_ADDR_MAX_STR_LEN > GNRC_IPV6_NIB_L2ADDR_MAX_LEN) ?
+             IPV6_ADDR_MAX_STR_LEN : GNRC_IPV6_NIB_L2ADDR_MAX_LEN];
+    gnrc_ipv6_dcache_stats_t stats;
+
+    for (unsigned i = 0; i < GNRC_IPV6_DCACHE_SIZE; i++) {
+        gnrc_ipv6_dcache_entry_t *entry = &_entries[i];
+
+        if (entry->gen != _gen) {
+            continue;
+        }
+        printf("%s ", ipv6_addr_to_str(str, &entry->dst, sizeof(str)));
+        printf("via %s ", ipv6_addr_to_str(str, &entry->next_hop, sizeof(str)));
+        printf("dev #%u ", (unsigned)entry->netif->pid);
+        printf("lladdr %s", gnrc_netif_addr_to_str(entry->l2addr,
+                                                   entry->l2addr_len,
+                                                   str));
+        if (!ipv6_addr_is_unspecified(&entry->src)) {
+            printf(" src %s", ipv6_addr_to_str(str, &entry->src, sizeof(str)));
+        }
+        puts("");
+    }
+    gnrc_ipv6_dcache_get_stats(&stats);
+    printf("hits: %" PRIu32 ", misses: %" PRIu32 ", flushes: %" PRIu32 "\n",
+           stats.hits, stats.misses, stats.flushes);
+}
+
+/** @} */
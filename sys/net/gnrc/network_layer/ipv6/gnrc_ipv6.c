@@ -18,15 +18,20 @@
 
 #include "byteorder.h"
 #include "cpu_conf.h"
+#include "irq.h"
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
+#include "net/icmpv6.h"
 #include "net/protnum.h"
+#include "net/tcp.h"
+#include "net/udp.h"
 #include "thread.h"
 #include "utlist.h"
 
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
 #include "net/gnrc/ipv6/whitelist.h"
@@ -246,13 +251,79 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+/* checks if a received packet can be handled without touching the NIB, i.e.
+ * if it carries UDP directly and is addressed to the receiving interface */
+static bool _inline_receivable(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6, *netif_hdr;
+    gnrc_netif_t *netif;
+    ipv6_hdr_t *hdr = NULL;
+
+    for (ipv6 = pkt; ipv6 != NULL; ipv6 = ipv6->next) {
+        if ((ipv6->type == GNRC_NETTYPE_IPV6) &&
+            (ipv6->size == sizeof(ipv6_hdr_t)) && ipv6_hdr_is(ipv6->data)) {
+            hdr = ipv6->data;
+            break;
+        }
+    }
+    if ((hdr == NULL) && (pkt->size >= sizeof(ipv6_hdr_t)) &&
+        ipv6_hdr_is(pkt->data)) {
+        hdr = pkt->data;
+    }
+    if ((hdr == NULL) || (hdr->nh != PROTNUM_UDP)) {
+        return false;
+    }
+    netif_hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    if (netif_hdr == NULL) {
+        return false;
+    }
+    netif = gnrc_netif_get_by_pid(((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid);
+    if (netif == NULL) {
+        return false;
+    }
+    if (ipv6_addr_is_multicast(&hdr->dst)) {
+        return (gnrc_netif_ipv6_group_idx(netif, &hdr->dst) >= 0);
+    }
+    return (gnrc_netif_ipv6_addr_idx(netif, &hdr->dst) >= 0);
+}
+
+static void _inline_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    int res;
+
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        if (_inline_receivable(pkt)) {
+            _receive(pkt);
+            return;
+        }
+        res = gnrc_netapi_receive(gnrc_ipv6_pid, pkt);
+    }
+    else {
+        res = gnrc_netapi_send(gnrc_ipv6_pid, pkt);
+    }
+    if (res < 1) {
+        DEBUG("ipv6: unable to queue packet to IPv6 thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _inline_cbd = { .cb = _inline_cb };
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            sched_active_pid);
+    gnrc_netreg_entry_t me_reg;
 
     (void)args;
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    gnrc_netreg_entry_init_cb(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL, &_inline_cbd);
+#else
+    gnrc_netreg_entry_init_pid(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+#endif
     msg_init_queue(msg_q, GNRC_IPV6_MSG_QUEUE_SIZE);
 
     /* register interest in all IPv6 packets */
@@ -389,8 +460,50 @@ static void _send_unicast(gnrc_netif_t *netif, uint8_t *dst_l2addr,
     _send_to_iface(netif, pkt);
 }
 
+/* puts the sum over the pseudo-header into the checksum field of payload for
+ * the network device to complete, returns false if it can't do that */
+static bool _set_pseudo_hdr_csum(gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *payload)
+{
+    ipv6_hdr_t *hdr = ipv6->data;
+    network_uint16_t *csum;
+    size_t hdr_size;
+
+    switch (payload->type) {
+#ifdef MODULE_GNRC_ICMPV6
+        case GNRC_NETTYPE_ICMPV6:
+            csum = &((icmpv6_hdr_t *)payload->data)->csum;
+            hdr_size = sizeof(icmpv6_hdr_t);
+            break;
+#endif
+#ifdef MODULE_GNRC_TCP
+        case GNRC_NETTYPE_TCP:
+            csum = &((tcp_hdr_t *)payload->data)->checksum;
+            hdr_size = sizeof(tcp_hdr_t);
+            break;
+#endif
+#ifdef MODULE_GNRC_UDP
+        case GNRC_NETTYPE_UDP:
+            csum = &((udp_hdr_t *)payload->data)->checksum;
+            hdr_size = sizeof(udp_hdr_t);
+            break;
+#endif
+        default:
+            return false;
+    }
+    /* the device only finds messages directly following the IPv6 header */
+    if ((payload->size < hdr_size) ||
+        (hdr->nh != gnrc_nettype_to_protnum(payload->type))) {
+        return false;
+    }
+    *csum = byteorder_htons(ipv6_hdr_inet_csum(0, hdr, hdr->nh,
+                                               byteorder_ntohs(hdr->len)));
+    return true;
+}
+
+/* csum_offload: the packet is sent over netif, so the device may complete
+ * the checksum of the upper header if it is able to */
 static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
-                          gnrc_pktsnip_t *payload)
+                          gnrc_pktsnip_t *payload, bool csum_offload)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -437,6 +550,13 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
         }
     }
 
+    if (csum_offload && (netif != NULL) &&
+        (netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD) &&
+        _set_pseudo_hdr_csum(ipv6, payload)) {
+        DEBUG("ipv6: leave checksum for upper header to the device.\n");
+        return 0;
+    }
+
     DEBUG("ipv6: calculate checksum for upper header.\n");
 
     if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
@@ -449,6 +569,28 @@ static int _fill_ipv6_hdr(gnrc_netif_t *netif, gnrc_pktsnip_t *ipv6,
     return 0;
 }
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+/* sets an unspecified source address of hdr to the one cached for its
+ * destination, which is selected on first use */
+static void _dcache_set_src(gnrc_ipv6_dcache_entry_t *dce, ipv6_hdr_t *hdr)
+{
+    if (!ipv6_addr_is_unspecified(&hdr->src)) {
+        return;
+    }
+    if (ipv6_addr_is_unspecified(&dce->src)) {
+        ipv6_addr_t *src = gnrc_netif_ipv6_addr_best_src(dce->netif, &hdr->dst,
+                                                         false);
+
+        if (src == NULL) {
+            /* leave it to _fill_ipv6_hdr() */
+            return;
+        }
+        memcpy(&dce->src, src, sizeof(dce->src));
+    }
+    memcpy(&hdr->src, &dce->src, sizeof(hdr->src));
+}
+#endif  /* MODULE_GNRC_IPV6_DCACHE */
+
 static inline void _send_multicast_over_iface(gnrc_netif_t *netif,
                                               gnrc_pktsnip_t *pkt)
 {
@@ -514,7 +656,7 @@ static void _send_multicast(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                     ptr = ptr->next;
                 }
 
-                if (_fill_ipv6_hdr(netif, ipv6, tmp) < 0) {
+                if (_fill_ipv6_hdr(netif, ipv6, tmp, true) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(ipv6);
                     return;
@@ -530,7 +672,7 @@ static void _send_multicast(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
     }
     else {
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(netif, ipv6, payload, true) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -551,7 +693,7 @@ static void _send_multicast(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
     }
 
     if (prep_hdr) {
-        if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+        if (_fill_ipv6_hdr(netif, ipv6, payload, true) < 0) {
             /* error on filling up header */
             gnrc_pktbuf_release(pkt);
             return;
@@ -621,7 +763,9 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         gnrc_pktsnip_t *ptr = ipv6, *rcv_pkt;
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+            /* the packet is not handed to the device, so its checksum needs
+             * to be complete */
+            if (_fill_ipv6_hdr(netif, ipv6, payload, false) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -656,6 +800,24 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     }
     else {
         gnrc_ipv6_nib_nc_t nce;
+#ifdef MODULE_GNRC_IPV6_DCACHE
+        gnrc_ipv6_dcache_entry_t *dce = gnrc_ipv6_dcache_get(&hdr->dst, iface);
+
+        if (dce != NULL) {
+            DEBUG("ipv6: use cached next hop for %s\n",
+                  ipv6_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)));
+            if (prep_hdr) {
+                _dcache_set_src(dce, hdr);
+                if (_fill_ipv6_hdr(dce->netif, ipv6, payload, true) < 0) {
+                    /* error on filling up header */
+                    gnrc_pktbuf_release(pkt);
+                    return;
+                }
+            }
+            _send_unicast(dce->netif, dce->l2addr, dce->l2addr_len, pkt);
+            return;
+        }
+#endif  /* MODULE_GNRC_IPV6_DCACHE */
         gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
 
         if (gnrc_ipv6_nib_get_next_hop_l2addr(&hdr->dst, netif, pkt,
@@ -663,11 +825,18 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
             /* packet is released by NIB */
             return;
         }
-        iface = gnrc_ipv6_nib_nc_get_iface(&nce);
-        netif = gnrc_netif_get_by_pid(iface);
+        netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
         assert(netif != NULL);
+#ifdef MODULE_GNRC_IPV6_DCACHE
+        dce = gnrc_ipv6_dcache_add(&hdr->dst, iface, netif, &nce);
+#endif  /* MODULE_GNRC_IPV6_DCACHE */
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(netif, ipv6, payload) < 0) {
+#ifdef MODULE_GNRC_IPV6_DCACHE
+            if (dce != NULL) {
+                _dcache_set_src(dce, hdr);
+            }
+#endif  /* MODULE_GNRC_IPV6_DCACHE */
+            if (_fill_ipv6_hdr(netif, ipv6, payload, true) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -715,8 +884,12 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #ifdef MODULE_NETSTATS_IPV6
         assert(iface);
         netstats_t *stats = &(gnrc_netif_get_by_pid(iface)->ipv6.stats);
+        /* with gnrc_netapi_inline, packets are received by both the
+         * interface's and the IPv6 thread */
+        unsigned state = irq_disable();
         stats->rx_count++;
         stats->rx_bytes += (gnrc_pkt_len(pkt) - netif->size);
+        irq_restore(state);
 #endif
     }
 
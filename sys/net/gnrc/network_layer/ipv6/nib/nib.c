@@ -20,6 +20,7 @@
 #include "net/ipv6/addr.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/netif/internal.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/pktqueue.h"
@@ -288,6 +289,8 @@ void gnrc_ipv6_nib_handle_pkt(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
             break;
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_DAD */
     }
+    /* neighbor discovery may change any next hop */
+    gnrc_ipv6_dcache_flush();
     mutex_unlock(&_nib_mutex);
     gnrc_netif_release(netif);
 }
@@ -302,10 +305,12 @@ void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type)
         case GNRC_IPV6_NIB_SND_UC_NS:
         case GNRC_IPV6_NIB_SND_MC_NS:
             _handle_snd_ns(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
         case GNRC_IPV6_NIB_REACH_TIMEOUT:
         case GNRC_IPV6_NIB_DELAY_TIMEOUT:
             _handle_state_timeout(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
         case GNRC_IPV6_NIB_RECALC_REACH_TIME:
             _recalc_reach_time(ctx);
@@ -326,11 +331,13 @@ void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type)
             break;
         case GNRC_IPV6_NIB_ROUTE_TIMEOUT:
             _nib_ft_remove(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
 #endif  /* GNRC_IPV6_NIB_CONF_ROUTER */
 #if GNRC_IPV6_NIB_CONF_6LR
         case GNRC_IPV6_NIB_ADDR_REG_TIMEOUT:
             _nib_nc_remove(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
 #endif  /* GNRC_IPV6_NIB_CONF_6LR */
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
@@ -340,13 +347,16 @@ void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type)
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
         case GNRC_IPV6_NIB_PFX_TIMEOUT:
             _handle_pfx_timeout(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
         case GNRC_IPV6_NIB_RTR_TIMEOUT:
             _handle_rtr_timeout(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
 #if GNRC_IPV6_NIB_CONF_6LN
         case GNRC_IPV6_NIB_REREG_ADDRESS:
             _handle_rereg_address(ctx);
+            gnrc_ipv6_dcache_flush();
             break;
 #endif  /* GNRC_IPV6_NIB_CONF_6LN */
         default:
@@ -1323,6 +1333,7 @@ static void _auto_configure_addr(gnrc_netif_t *netif, const ipv6_addr_t *pfx,
          *    locked here) */
         netif->ipv6.addrs_flags[idx] &= ~GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_MASK;
         netif->ipv6.addrs_flags[idx] |= GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID;
+        gnrc_ipv6_dcache_flush();
     }
 #endif  /* GNRC_IPV6_NIB_CONF_6LN */
     (void)idx;
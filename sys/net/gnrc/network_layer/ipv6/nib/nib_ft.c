@@ -18,6 +18,7 @@
 
 #include "_nib-internal.h"
 
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ipv6/nib/ft.h"
 
 int gnrc_ipv6_nib_ft_get(const ipv6_addr_t *dst, gnrc_pktsnip_t *pkt,
@@ -78,6 +79,7 @@ int gnrc_ipv6_nib_ft_add(const ipv6_addr_t *dst, unsigned dst_len,
         res = -ENOTSUP;
     }
 #endif
+    gnrc_ipv6_dcache_flush();
     mutex_unlock(&_nib_mutex);
     return res;
 }
@@ -105,6 +107,7 @@ void gnrc_ipv6_nib_ft_del(const ipv6_addr_t *dst, unsigned dst_len)
         }
     }
 #endif
+    gnrc_ipv6_dcache_flush();
     mutex_unlock(&_nib_mutex);
 }
 
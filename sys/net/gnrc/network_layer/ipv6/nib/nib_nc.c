@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/netif.h"
 
 #include "net/gnrc/ipv6/nib/nc.h"
@@ -51,6 +52,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK);
     node->info |= (GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL |
                    GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
+    gnrc_ipv6_dcache_flush();
     mutex_unlock(&_nib_mutex);
     return 0;
 }
@@ -64,6 +66,7 @@ void gnrc_ipv6_nib_nc_del(const ipv6_addr_t *ipv6, unsigned iface)
         if ((_nib_onl_get_if(node) == iface) &&
             ipv6_addr_equal(ipv6, &node->ipv6)) {
             _nib_nc_remove(node);
+            gnrc_ipv6_dcache_flush();
             break;
         }
     }
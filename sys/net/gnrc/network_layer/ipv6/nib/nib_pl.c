@@ -17,6 +17,7 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ipv6/nib/pl.h"
 #include "net/gnrc/netif/internal.h"
 #include "timex.h"
@@ -54,6 +55,7 @@ int gnrc_ipv6_nib_pl_set(unsigned iface,
     int idx;
 
     if (netif == NULL) {
+        gnrc_ipv6_dcache_flush();
         mutex_unlock(&_nib_mutex);
         return res;
     }
@@ -78,6 +80,7 @@ int gnrc_ipv6_nib_pl_set(unsigned iface,
 #endif
     gnrc_netif_release(netif);
 #endif  /* MODULE_GNRC_NETIF */
+    gnrc_ipv6_dcache_flush();
     mutex_unlock(&_nib_mutex);
 #if defined(MODULE_GNRC_NETIF) && GNRC_IPV6_NIB_CONF_ROUTER
     /* update prefixes down-stream */
@@ -99,6 +102,7 @@ void gnrc_ipv6_nib_pl_del(unsigned iface,
             ((iface == 0) || (iface == _nib_onl_get_if(dst->next_hop))) &&
             (ipv6_addr_match_prefix(pfx, &dst->pfx) >= pfx_len)) {
             _nib_pl_remove(dst);
+            gnrc_ipv6_dcache_flush();
             mutex_unlock(&_nib_mutex);
 #if GNRC_IPV6_NIB_CONF_ROUTER
             gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
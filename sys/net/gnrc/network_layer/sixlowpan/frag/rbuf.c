@@ -22,6 +22,7 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/sixlowpan.h"
+#include "memp.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
@@ -43,6 +44,7 @@
 #endif
 
 static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+static memp_t rbuf_int_pool;
 
 static rbuf_t rbuf[RBUF_SIZE];
 
@@ -55,8 +57,6 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
  * ------------------------------------*/
 /* checks whether start and end overlaps, but not identical to, given interval i */
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static rbuf_int_t *_rbuf_int_get_free(void);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
 /* update interval buffer of entry */
@@ -80,6 +80,11 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     rbuf_int_t *ptr;
     uint8_t *data = ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
 
+    if (rbuf_int_pool.numof == 0) {
+        memp_init(&rbuf_int_pool, "6lo rbuf intervals", rbuf_int,
+                  sizeof(rbuf_int_t), RBUF_INT_SIZE);
+    }
+
     _rbuf_gc();
     entry = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                       gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
@@ -196,25 +201,12 @@ static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, ui
         ((start != i->start) || (end != i->end)); /* not identical */
 }
 
-static rbuf_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
-
-    return NULL;
-}
-
 static void _rbuf_rem(rbuf_t *entry)
 {
     while (entry->ints != NULL) {
         rbuf_int_t *next = entry->ints->next;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
+        memp_free(&rbuf_int_pool, entry->ints);
         entry->ints = next;
     }
 
@@ -226,7 +218,7 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
     rbuf_int_t *new;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
-    new = _rbuf_int_get_free();
+    new = memp_alloc(&rbuf_int_pool);
 
     if (new == NULL) {
         DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
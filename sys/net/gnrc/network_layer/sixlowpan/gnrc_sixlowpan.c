@@ -307,13 +307,53 @@ static void _send(gnrc_pktsnip_t *pkt)
 #endif
 }
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+static void _inline_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    int res;
+
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+        gnrc_pktsnip_t *sixlowpan = gnrc_pktsnip_search_type(pkt,
+                                                             GNRC_NETTYPE_SIXLOWPAN);
+
+        /* the reassembly buffer belongs to the 6LoWPAN thread */
+        if ((sixlowpan == NULL) || (sixlowpan->size < 1) ||
+            !sixlowpan_frag_is(sixlowpan->data)) {
+            _receive(pkt);
+            return;
+        }
+#else
+        _receive(pkt);
+        return;
+#endif
+        res = gnrc_netapi_receive(_pid, pkt);
+    }
+    else {
+        res = gnrc_netapi_send(_pid, pkt);
+    }
+    if (res < 1) {
+        DEBUG("6lo: unable to queue packet to 6LoWPAN thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _inline_cbd = { .cb = _inline_cb };
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            sched_active_pid);
+    gnrc_netreg_entry_t me_reg;
 
     (void)args;
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    gnrc_netreg_entry_init_cb(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL, &_inline_cbd);
+#else
+    gnrc_netreg_entry_init_pid(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+#endif
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
 
     /* register interest in all 6LoWPAN packets */
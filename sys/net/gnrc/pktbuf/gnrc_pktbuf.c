@@ -16,6 +16,17 @@
 #include <sys/uio.h>
 
 #include "net/gnrc/pktbuf.h"
+#include "pktbuf_internal.h"
+
+#ifdef MODULE_GNRC_PKTBUF_STATS
+static gnrc_pktbuf_type_stats_t _type_stats[GNRC_PKTBUF_STATS_TYPES];
+
+static inline gnrc_pktbuf_type_stats_t *_stats_of(gnrc_nettype_t type)
+{
+    assert((type >= GNRC_NETTYPE_IOVEC) && (type < GNRC_NETTYPE_NUMOF));
+    return &_type_stats[type - GNRC_NETTYPE_IOVEC];
+}
+#endif
 
 gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
 {
@@ -86,5 +97,49 @@ gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt,
     return pkt;
 }
 
+#ifdef MODULE_GNRC_PKTBUF_STATS
+void gnrc_pktbuf_stats_init(void)
+{
+    memset(_type_stats, 0, sizeof(_type_stats));
+}
+
+void gnrc_pktbuf_stats_add(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktbuf_type_stats_t *stats = _stats_of(pkt->type);
+
+    pkt->owner = pkt->type;
+    stats->bytes += pkt->size;
+    if (++stats->snips > stats->max_snips) {
+        stats->max_snips = stats->snips;
+    }
+}
+
+void gnrc_pktbuf_stats_remove(const gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktbuf_type_stats_t *stats = _stats_of(pkt->owner);
+
+    assert((stats->snips > 0) && (stats->bytes >= pkt->size));
+    stats->bytes -= pkt->size;
+    stats->snips--;
+}
+
+void gnrc_pktbuf_stats_resize(const gnrc_pktsnip_t *pkt, size_t size)
+{
+    gnrc_pktbuf_type_stats_t *stats = _stats_of(pkt->owner);
+
+    assert(stats->bytes >= pkt->size);
+    stats->bytes = stats->bytes - pkt->size + size;
+}
+
+void gnrc_pktbuf_stats_fail(gnrc_nettype_t type)
+{
+    _stats_of(type)->fails++;
+}
+
+void gnrc_pktbuf_stats_get_types(gnrc_pktbuf_stats_t *stats)
+{
+    memcpy(stats->types, _type_stats, sizeof(_type_stats));
+}
+#endif
 
 /** @} */
@@ -0,0 +1,106 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Accounting shared by the packet buffer implementations
+ *
+ * All functions are called with the lock of the implementation held.
+ * Without the `gnrc_pktbuf_stats` module they compile to nothing.
+ *
+ * @internal
+ */
+#ifndef PKTBUF_INTERNAL_H
+#define PKTBUF_INTERNAL_H
+
+#include <stddef.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Resets the statistics on gnrc_pktbuf_init()
+ */
+void gnrc_pktbuf_stats_init(void);
+
+/**
+ * @brief   Accounts a new snip to its type
+ *
+ * @param[in] pkt   A snip with gnrc_pktsnip_t::type and gnrc_pktsnip_t::size
+ *                  set.
+ */
+void gnrc_pktbuf_stats_add(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Removes a snip that is freed from the statistics
+ *
+ * @param[in] pkt   A snip accounted by gnrc_pktbuf_stats_add().
+ */
+void gnrc_pktbuf_stats_remove(const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Accounts a change of gnrc_pktsnip_t::size
+ *
+ * @param[in] pkt   A snip accounted by gnrc_pktbuf_stats_add(), with the
+ *                  old size still set.
+ * @param[in] size  The new size of @p pkt.
+ */
+void gnrc_pktbuf_stats_resize(const gnrc_pktsnip_t *pkt, size_t size);
+
+/**
+ * @brief   Counts a failed allocation
+ *
+ * @param[in] type  The type that was to be allocated.
+ */
+void gnrc_pktbuf_stats_fail(gnrc_nettype_t type);
+
+/**
+ * @brief   Copies the per-type statistics
+ *
+ * @param[out] stats    Statistics to fill gnrc_pktbuf_stats_t::types of.
+ */
+void gnrc_pktbuf_stats_get_types(gnrc_pktbuf_stats_t *stats);
+#else
+static inline void gnrc_pktbuf_stats_init(void)
+{
+}
+
+static inline void gnrc_pktbuf_stats_add(gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+}
+
+static inline void gnrc_pktbuf_stats_remove(const gnrc_pktsnip_t *pkt)
+{
+    (void)pkt;
+}
+
+static inline void gnrc_pktbuf_stats_resize(const gnrc_pktsnip_t *pkt, size_t size)
+{
+    (void)pkt;
+    (void)size;
+}
+
+static inline void gnrc_pktbuf_stats_fail(gnrc_nettype_t type)
+{
+    (void)type;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKTBUF_INTERNAL_H */
+/** @} */
@@ -32,6 +32,7 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "pktbuf_internal.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -81,6 +82,7 @@ void gnrc_pktbuf_init(void)
 #ifdef TEST_SUITES
     mallocs = 0;
 #endif
+    gnrc_pktbuf_stats_init();
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
@@ -88,12 +90,14 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
 {
     gnrc_pktsnip_t *pkt;
 
+    mutex_lock(&_mutex);
     if (size > GNRC_PKTBUF_SIZE) {
         DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
               (unsigned)size, GNRC_PKTBUF_SIZE);
+        gnrc_pktbuf_stats_fail(type);
+        mutex_unlock(&_mutex);
         return NULL;
     }
-    mutex_lock(&_mutex);
     pkt = _create_snip(next, data, size, type);
     mutex_unlock(&_mutex);
     return pkt;
@@ -115,11 +119,14 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     header = _malloc(sizeof(gnrc_pktsnip_t));
     if (header == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
+        gnrc_pktbuf_stats_fail(type);
         return NULL;
     }
     if (pkt->size == size) {
+        gnrc_pktbuf_stats_resize(pkt, 0);
         _set_pktsnip(header, pkt->next, pkt->data, size, type);
         _set_pktsnip(pkt, header, NULL, 0, pkt->type);
+        gnrc_pktbuf_stats_add(header);
         return header;
     }
     /* we can not just "snip off" something from the end of a malloc'd section
@@ -128,6 +135,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     if (payload == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
         _free(header);
+        gnrc_pktbuf_stats_fail(type);
         return NULL;
     }
     memcpy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
@@ -136,11 +144,14 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
         DEBUG("pktbuf: could not reallocate marked section.\n");
         _free(payload);
         _free(header);
+        gnrc_pktbuf_stats_fail(type);
         return NULL;
     }
     pkt->data = payload;
+    gnrc_pktbuf_stats_resize(pkt, pkt->size - size);
     pkt->size -= size;
     _set_pktsnip(header, pkt->next, header_data, size, type);
+    gnrc_pktbuf_stats_add(header);
     pkt->next = header;
     return header;
 }
@@ -175,10 +186,12 @@ static int _realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         void *data = (pkt->data) ? realloc(pkt->data, size) : _malloc(size);
         if (data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
+            gnrc_pktbuf_stats_fail(pkt->type);
             return ENOMEM;
         }
         pkt->data = data;
     }
+    gnrc_pktbuf_stats_resize(pkt, size);
     pkt->size = size;
     return 0;
 }
@@ -210,6 +223,7 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
+            gnrc_pktbuf_stats_remove(pkt);
             _free(pkt->data);
             _free(pkt);
         }
@@ -256,6 +270,23 @@ void gnrc_pktbuf_stats(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_STATS
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    /* the heap is not ours to inspect */
+    stats->size = 0;
+    stats->used = 0;
+    stats->largest_free = 0;
+    gnrc_pktbuf_stats_get_types(stats);
+    for (unsigned i = 0; i < GNRC_PKTBUF_STATS_TYPES; i++) {
+        stats->used += stats->types[i].bytes +
+                       (stats->types[i].snips * sizeof(gnrc_pktsnip_t));
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
@@ -278,6 +309,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
 
     if (pkt == NULL) {
         DEBUG("pktbuf: error allocating new packet snip\n");
+        gnrc_pktbuf_stats_fail(type);
         return NULL;
     }
     if (size > 0) {
@@ -285,10 +317,12 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
             _free(pkt);
+            gnrc_pktbuf_stats_fail(type);
             return NULL;
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    gnrc_pktbuf_stats_add(pkt);
     if (data != NULL) {
         memcpy(_data, data, size);
     }
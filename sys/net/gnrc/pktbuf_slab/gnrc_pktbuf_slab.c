@@ -0,0 +1,543 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer with separate slabs of fixed-size blocks
+ *
+ * Every allocation takes one block from the free list of the smallest
+ * fitting slab, so allocating and freeing is O(1) and the buffer never
+ * fragments.  Snip descriptors come from their own slab, data from the small,
+ * the frame or the large one.  If a slab is exhausted, the next larger one is
+ * used.
+ *
+ * The block of any pointer into a slab is found by its address, so data may
+ * shrink from its front (see gnrc_pktbuf_mark()) and grow in place up to the
+ * end of its block.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+#include "pktbuf_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(void *) - 1)
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _SNIP_SIZE          _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _SMALL_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_SMALL_SIZE)
+#define _FRAME_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_FRAME_SIZE)
+#define _LARGE_SIZE         _ALIGN(GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+#if (GNRC_PKTBUF_SLAB_SNIP_NUMOF == 0) || (GNRC_PKTBUF_SLAB_SMALL_NUMOF == 0) || \
+    (GNRC_PKTBUF_SLAB_FRAME_NUMOF == 0) || (GNRC_PKTBUF_SLAB_LARGE_NUMOF == 0)
+#error "gnrc_pktbuf_slab: every slab needs at least one block"
+#endif
+
+/**
+ * @brief   Slab classes, in the order of their block size
+ */
+enum {
+    _SLAB_SNIP = 0,
+    _SLAB_SMALL,
+    _SLAB_FRAME,
+    _SLAB_LARGE,
+    _SLAB_NUMOF,
+};
+
+typedef struct _free_block {
+    struct _free_block *next;
+} _free_block_t;
+
+typedef struct {
+    uint8_t *mem;               /**< first block */
+    size_t block_size;          /**< size of a block */
+    unsigned numof;             /**< number of blocks */
+    _free_block_t *free;        /**< free blocks */
+    unsigned used;              /**< number of blocks in use */
+#ifdef DEVELHELP
+    unsigned max_used;          /**< maximum number of blocks in use */
+    unsigned empty;             /**< allocations that found no free block */
+#endif
+} _slab_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+static uint8_t _snip_mem[GNRC_PKTBUF_SLAB_SNIP_NUMOF * _SNIP_SIZE]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _small_mem[GNRC_PKTBUF_SLAB_SMALL_NUMOF * _SMALL_SIZE]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _frame_mem[GNRC_PKTBUF_SLAB_FRAME_NUMOF * _FRAME_SIZE]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _large_mem[GNRC_PKTBUF_SLAB_LARGE_NUMOF * _LARGE_SIZE]
+    __attribute__((aligned(sizeof(void *))));
+
+static _slab_t _slabs[_SLAB_NUMOF] = {
+    { .mem = _snip_mem, .block_size = _SNIP_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_SNIP_NUMOF },
+    { .mem = _small_mem, .block_size = _SMALL_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_SMALL_NUMOF },
+    { .mem = _frame_mem, .block_size = _FRAME_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_FRAME_NUMOF },
+    { .mem = _large_mem, .block_size = _LARGE_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_LARGE_NUMOF },
+};
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(unsigned slab, size_t size);
+static void _pktbuf_free(void *data);
+
+static inline _slab_t *_slab_of(const void *ptr)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        if ((size_t)((const uint8_t *)ptr - slab->mem) <
+            (slab->numof * slab->block_size)) {
+            return slab;
+        }
+    }
+    return NULL;
+}
+
+static inline uint8_t *_block_of(const _slab_t *slab, const void *ptr)
+{
+    size_t offset = (const uint8_t *)ptr - slab->mem;
+
+    return slab->mem + (offset - (offset % slab->block_size));
+}
+
+/* space from ptr to the end of its block */
+static inline size_t _space(const void *ptr)
+{
+    const _slab_t *slab = _slab_of(ptr);
+
+    assert(slab != NULL);
+    return slab->block_size - ((const uint8_t *)ptr - _block_of(slab, ptr));
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        _slab_t *slab = &_slabs[i];
+
+        /* chain the blocks in order of their address */
+        slab->free = NULL;
+        for (unsigned n = slab->numof; n > 0; n--) {
+            _free_block_t *block = (_free_block_t *)(slab->mem +
+                                                     (n - 1) * slab->block_size);
+            block->next = slab->free;
+            slab->free = block;
+        }
+        slab->used = 0;
+#ifdef DEVELHELP
+        slab->max_used = 0;
+        slab->empty = 0;
+#endif
+    }
+    gnrc_pktbuf_stats_init();
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    mutex_lock(&_mutex);
+    if (size > _LARGE_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)_LARGE_SIZE);
+        gnrc_pktbuf_stats_fail(type);
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(_SLAB_SNIP, sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        gnrc_pktbuf_stats_fail(type);
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->size != size) {
+        /* the marked header moves to a block of its own, the remainder
+         * stays where it is */
+        new_data_marked = _pktbuf_alloc(_SLAB_SMALL, size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip);
+            gnrc_pktbuf_stats_fail(type);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        new_data_marked = pkt->data;
+        pkt->data = NULL;
+    }
+    gnrc_pktbuf_stats_resize(pkt, pkt->size - size);
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    gnrc_pktbuf_stats_add(marked_snip);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _slab_of(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data);
+        pkt->data = NULL;
+    }
+    /* new size does not fit into the current block */
+    else if ((pkt->data == NULL) || (size > _space(pkt->data))) {
+        void *new_data = _pktbuf_alloc(_SLAB_SMALL, size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            gnrc_pktbuf_stats_fail(pkt->type);
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+            _pktbuf_free(pkt->data);
+        }
+        pkt->data = new_data;
+    }
+    gnrc_pktbuf_stats_resize(pkt, size);
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_slab_of(pkt) != NULL);
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            gnrc_pktbuf_stats_remove(pkt);
+            _pktbuf_free(pkt->data);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    static const char *names[_SLAB_NUMOF] = { "snips", "small", "frame",
+                                                  "large" };
+
+    mutex_lock(&_mutex);
+    printf("packet buffer: %u bytes in %u slabs\n",
+           (unsigned)(sizeof(_snip_mem) + sizeof(_small_mem) +
+                      sizeof(_frame_mem) + sizeof(_large_mem)),
+           _SLAB_NUMOF);
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+
+        printf("  %-5s: %3u of %3u blocks of %4u bytes used (max: %3u, "
+               "found empty: %u)\n", names[i], slab->used, slab->numof,
+               (unsigned)slab->block_size, slab->max_used, slab->empty);
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_STATS
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    stats->size = 0;
+    stats->used = 0;
+    stats->largest_free = 0;
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+
+        stats->size += slab->numof * slab->block_size;
+        stats->used += slab->used * slab->block_size;
+        /* data can only be allocated together with a snip descriptor */
+        if ((i != _SLAB_SNIP) && (slab->free != NULL) &&
+            (_slabs[_SLAB_SNIP].free != NULL)) {
+            stats->largest_free = slab->block_size;
+        }
+    }
+    gnrc_pktbuf_stats_get_types(stats);
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation, for every slab:
+     *  - every block in the free list is the start of a block of the slab
+     *  - the free list is not cyclic and holds exactly (numof - used) blocks
+     */
+    for (unsigned i = 0; i < _SLAB_NUMOF; i++) {
+        const _slab_t *slab = &_slabs[i];
+        unsigned free = 0;
+
+        for (const _free_block_t *ptr = slab->free; ptr; ptr = ptr->next) {
+            if ((_slab_of(ptr) != slab) ||
+                (_block_of(slab, ptr) != (const uint8_t *)ptr) ||
+                (++free > slab->numof)) {
+                return false;
+            }
+        }
+        if ((free + slab->used) != slab->numof) {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(_SLAB_SNIP, sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        gnrc_pktbuf_stats_fail(type);
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(_SLAB_SMALL, size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            gnrc_pktbuf_stats_fail(type);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    gnrc_pktbuf_stats_add(pkt);
+    if ((data != NULL) && (_data != NULL)) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_pktbuf_alloc(unsigned slab, size_t size)
+{
+    for (; slab < _SLAB_NUMOF; slab++) {
+        _slab_t *s = &_slabs[slab];
+
+        if ((size <= s->block_size) && (s->free != NULL)) {
+            _free_block_t *block = s->free;
+
+            s->free = block->next;
+            s->used++;
+#ifdef DEVELHELP
+            if (s->used > s->max_used) {
+                s->max_used = s->used;
+            }
+#endif
+            return block;
+        }
+#ifdef DEVELHELP
+        if (size <= s->block_size) {
+            s->empty++;
+        }
+#endif
+    }
+    DEBUG("pktbuf: no block left for %u bytes\n", (unsigned)size);
+    return NULL;
+}
+
+static void _pktbuf_free(void *data)
+{
+    _slab_t *slab = _slab_of(data);
+    _free_block_t *block;
+
+    if (slab == NULL) {
+        return;
+    }
+    block = (_free_block_t *)_block_of(slab, data);
+    block->next = slab->free;
+    slab->free = block;
+    assert(slab->used > 0);
+    slab->used--;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
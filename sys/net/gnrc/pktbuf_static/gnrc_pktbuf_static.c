@@ -29,6 +29,7 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "pktbuf_internal.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -85,6 +86,7 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+    gnrc_pktbuf_stats_init();
     mutex_unlock(&_mutex);
 }
 
@@ -93,12 +95,14 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
 {
     gnrc_pktsnip_t *pkt;
 
+    mutex_lock(&_mutex);
     if (size > GNRC_PKTBUF_SIZE) {
         DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
               (unsigned)size, GNRC_PKTBUF_SIZE);
+        gnrc_pktbuf_stats_fail(type);
+        mutex_unlock(&_mutex);
         return NULL;
     }
-    mutex_lock(&_mutex);
     pkt = _create_snip(next, data, size, type);
     mutex_unlock(&_mutex);
     return pkt;
@@ -125,6 +129,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
+        gnrc_pktbuf_stats_fail(type);
         mutex_unlock(&_mutex);
         return NULL;
     }
@@ -137,6 +142,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            gnrc_pktbuf_stats_fail(type);
             mutex_unlock(&_mutex);
             return NULL;
         }
@@ -145,6 +151,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
             DEBUG("pktbuf: could not reallocate remaining section.\n");
             _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
             _pktbuf_free(new_data_marked, size);
+            gnrc_pktbuf_stats_fail(type);
             mutex_unlock(&_mutex);
             return NULL;
         }
@@ -160,8 +167,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
                                           NULL;
     }
+    gnrc_pktbuf_stats_resize(pkt, pkt->size - size);
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    gnrc_pktbuf_stats_add(marked_snip);
     pkt->next = marked_snip;
     mutex_unlock(&_mutex);
     return marked_snip;
@@ -194,6 +203,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         void *new_data = _pktbuf_alloc(size);
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
+            gnrc_pktbuf_stats_fail(pkt->type);
             mutex_unlock(&_mutex);
             return ENOMEM;
         }
@@ -207,6 +217,7 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
                      pkt->size - aligned_size);
     }
+    gnrc_pktbuf_stats_resize(pkt, size);
     pkt->size = size;
     mutex_unlock(&_mutex);
     return 0;
@@ -231,6 +242,7 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
+            gnrc_pktbuf_stats_remove(pkt);
             _pktbuf_free(pkt->data, pkt->size);
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
         }
@@ -328,6 +340,26 @@ void gnrc_pktbuf_stats(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_STATS
+void gnrc_pktbuf_get_stats(gnrc_pktbuf_stats_t *stats)
+{
+    size_t free = 0;
+
+    mutex_lock(&_mutex);
+    stats->size = GNRC_PKTBUF_SIZE;
+    stats->largest_free = 0;
+    for (_unused_t *ptr = _first_unused; ptr != NULL; ptr = ptr->next) {
+        free += ptr->size;
+        if (ptr->size > stats->largest_free) {
+            stats->largest_free = ptr->size;
+        }
+    }
+    stats->used = GNRC_PKTBUF_SIZE - free;
+    gnrc_pktbuf_stats_get_types(stats);
+    mutex_unlock(&_mutex);
+}
+#endif
+
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
@@ -375,6 +407,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
 
     if (pkt == NULL) {
         DEBUG("pktbuf: error allocating new packet snip\n");
+        gnrc_pktbuf_stats_fail(type);
         return NULL;
     }
     if (size > 0) {
@@ -382,10 +415,12 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
             _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            gnrc_pktbuf_stats_fail(type);
             return NULL;
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    gnrc_pktbuf_stats_add(pkt);
     if (data != NULL) {
         memcpy(_data, data, size);
     }
@@ -28,6 +28,7 @@
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/netif/internal.h"
 #endif
 
 #define ENABLE_DEBUG (0)
@@ -146,8 +147,14 @@ static int _receive(gnrc_pktsnip_t *pkt)
         pkt->type = GNRC_NETTYPE_UNDEF;
     }
 
-    /* Validate checksum */
-    if (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt)) {
+    /* Validate checksum, unless the network device already did */
+#ifdef MODULE_GNRC_IPV6
+    bool csum_offloaded = gnrc_netif_ipv6_rx_csum_offloaded(ip, PROTNUM_TCP);
+#else
+    bool csum_offloaded = false;
+#endif
+    if (!csum_offloaded &&
+        (byteorder_ntohs(hdr->checksum) != _pkt_calc_csum(tcp, ip, pkt))) {
         DEBUG("gnrc_tcp_eventloop.c : _receive() : Invalid checksum\n");
         gnrc_pktbuf_release(pkt);
         return -EINVAL;
@@ -32,10 +32,8 @@ rcvbuf_t _static_buf;
 void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
-    mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
+    memp_init(&(_static_buf.pool), "gnrc_tcp_rcvbuf", _static_buf.buffers,
+              GNRC_TCP_RCV_BUF_SIZE, GNRC_TCP_RCV_BUFFERS);
 }
 
 /**
@@ -46,18 +44,8 @@ void _rcvbuf_init(void)
  */
 static void* _rcvbuf_alloc(void)
 {
-    void *result = NULL;
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
-            break;
-        }
-    }
-    mutex_unlock(&(_static_buf.lock));
-    return result;
+    return memp_alloc(&(_static_buf.pool));
 }
 
 /**
@@ -68,13 +56,7 @@ static void* _rcvbuf_alloc(void)
 static void _rcvbuf_free(void * const buf)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
-    mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
-    }
-    mutex_unlock(&(_static_buf.lock));
+    memp_free(&(_static_buf.pool), buf);
 }
 
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
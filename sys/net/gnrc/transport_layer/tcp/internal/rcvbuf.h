@@ -23,7 +23,7 @@
 #define RCVBUF_H
 
 #include <stdint.h>
-#include "mutex.h"
+#include "memp.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
 
@@ -31,20 +31,13 @@
 extern "C" {
 #endif
 
-/**
- * @brief Receive buffer entry.
- */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
-
 /**
  * @brief   Stuct holding receive buffers.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    memp_t pool;                                  /**< Pool the buffers are allocated from */
+    uint8_t buffers[GNRC_TCP_RCV_BUFFERS][MEMP_BLOCK_SIZE(GNRC_TCP_RCV_BUF_SIZE)]
+        __attribute__((aligned(sizeof(void *)))); /**< Receive buffer storage */
 } rcvbuf_t;
 
 /**
@@ -27,6 +27,7 @@
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
+#include "net/gnrc/netif/internal.h"
 #include "net/inet_csum.h"
 
 
@@ -145,7 +146,8 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    if (!gnrc_netif_ipv6_rx_csum_offloaded(ipv6, PROTNUM_UDP) &&
+        (_calc_csum(udp, ipv6, pkt) != 0xFFFF)) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
         gnrc_pktbuf_release(pkt);
         return;
@@ -217,13 +219,36 @@ static void _send(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETAPI_INLINE
+static void _inline_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    if (cmd == GNRC_NETAPI_MSG_TYPE_RCV) {
+        /* receiving does not touch any state of the UDP thread */
+        _receive(pkt);
+    }
+    else if (gnrc_netapi_send(_pid, pkt) < 1) {
+        DEBUG("udp: unable to queue packet to UDP thread\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static gnrc_netreg_entry_cbd_t _inline_cbd = { .cb = _inline_cb };
+#endif
+
 static void *_event_loop(void *arg)
 {
     (void)arg;
     msg_t msg, reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
-    gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
-                                                            sched_active_pid);
+    gnrc_netreg_entry_t netreg;
+
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    gnrc_netreg_entry_init_cb(&netreg, GNRC_NETREG_DEMUX_CTX_ALL, &_inline_cbd);
+#else
+    gnrc_netreg_entry_init_pid(&netreg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               sched_active_pid);
+#endif
     /* preset reply message */
     reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
     reply.content.value = (uint32_t)-ENOTSUP;
@@ -58,7 +58,8 @@ extern "C" {
  * @brief           If a thread attempts to acquire a held lock,
  *                  the holding thread gets its dynamic priority increased up to
  *                  the priority of the blocked thread
- * @note            Not implemented, yet.
+ * @note            Only supported with module `core_mutex_priority_inheritance`,
+ *                  which enables priority inheritance for all mutexes.
  */
 #define PTHREAD_PRIO_NONE        0
 #define PTHREAD_PRIO_INHERIT     1
@@ -158,7 +159,8 @@ int pthread_mutexattr_settype(pthread_mutexattr_t *attr, int kind);
 
 /**
  * @brief            Query the priority inheritance of the mutex to create.
- * @note             This implementation only supports `PTHREAD_PRIO_NONE` mutexes.
+ * @note             `PTHREAD_PRIO_INHERIT` is only supported with module
+ *                   `core_mutex_priority_inheritance`.
  * @param[in]        attr       Attribute set to query
  * @param[out]       protocol   Either #PTHREAD_PRIO_NONE or #PTHREAD_PRIO_INHERIT or #PTHREAD_PRIO_PROTECT.
  * @returns         `0` on success.
@@ -168,7 +170,9 @@ int pthread_mutexattr_getprotocol(const pthread_mutexattr_t *attr, int *protocol
 
 /**
  * @brief            Sets the priority inheritance of the mutex to create.
- * @note             This implementation only supports `PTHREAD_PRIO_NONE` mutexes.
+ * @note             `PTHREAD_PRIO_INHERIT` is only supported with module
+ *                   `core_mutex_priority_inheritance`. `PTHREAD_PRIO_PROTECT`
+ *                   is not supported.
  * @param[in,out]    attr       Attribute set to change.
  * @param[in]        protocol   Either #PTHREAD_PRIO_NONE or #PTHREAD_PRIO_INHERIT or #PTHREAD_PRIO_PROTECT.
  * @returns         `0` on success.
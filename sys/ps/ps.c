@@ -65,6 +65,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches"
+#ifdef MODULE_SCHED_ROUND_ROBIN
+           " | slices"
+#endif
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -124,6 +127,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
+#ifdef MODULE_SCHED_ROUND_ROBIN
+                   " | %6u"
+#endif
 #endif
                    "\n",
                    p->pid,
@@ -136,6 +142,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
+#ifdef MODULE_SCHED_ROUND_ROBIN
+                   , sched_pidlist[i].slices
+#endif
 #endif
                   );
         }
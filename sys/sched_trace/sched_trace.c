@@ -0,0 +1,112 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_trace
+ * @{
+ *
+ * @file
+ * @brief       Scheduler trace implementation
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "sched.h"
+#include "sched_trace.h"
+#include "thread.h"
+#include "xtimer.h"
+
+static sched_trace_entry_t _ring[SCHED_TRACE_SIZE];
+
+/* total number of records written since the last clear, the slot of a record
+ * is its sequence number modulo SCHED_TRACE_SIZE */
+static atomic_uint _head = ATOMIC_VAR_INIT(0);
+static volatile uint8_t _enabled;
+
+void sched_trace_record(uint8_t event, kernel_pid_t pid, uint16_t arg)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    /* reserving the slot first keeps an interrupting writer from clobbering
+     * this record */
+    unsigned seq = atomic_fetch_add_explicit(&_head, 1, memory_order_relaxed);
+    sched_trace_entry_t *entry = &_ring[seq & (SCHED_TRACE_SIZE - 1)];
+
+    entry->time = xtimer_now().ticks32;
+    entry->event = event;
+    entry->pid = (uint8_t)pid;
+    entry->arg = arg;
+}
+
+void sched_trace_start(void)
+{
+    _enabled = 1;
+}
+
+void sched_trace_stop(void)
+{
+    _enabled = 0;
+}
+
+void sched_trace_clear(void)
+{
+    atomic_store(&_head, 0);
+}
+
+unsigned sched_trace_read(sched_trace_entry_t *buf, unsigned max)
+{
+    unsigned head = atomic_load(&_head);
+    unsigned numof = (head > SCHED_TRACE_SIZE) ? SCHED_TRACE_SIZE : head;
+
+    if (numof > max) {
+        numof = max;
+    }
+
+    for (unsigned i = 0; i < numof; i++) {
+        buf[i] = _ring[(head - numof + i) & (SCHED_TRACE_SIZE - 1)];
+    }
+
+    return numof;
+}
+
+void sched_trace_dump(void)
+{
+    uint8_t enabled = _enabled;
+    _enabled = 0;
+
+    unsigned head = atomic_load(&_head);
+    unsigned numof = (head > SCHED_TRACE_SIZE) ? SCHED_TRACE_SIZE : head;
+
+    printf("trace: start hz=%lu records=%u lost=%u\n",
+           (unsigned long)XTIMER_HZ, numof, head - numof);
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        if (sched_threads[pid] == NULL) {
+            continue;
+        }
+#ifdef DEVELHELP
+        printf("trace: thread %u %s\n", (unsigned)pid, thread_getname(pid));
+#else
+        printf("trace: thread %u pid%u\n", (unsigned)pid, (unsigned)pid);
+#endif
+    }
+
+    for (unsigned i = 0; i < numof; i++) {
+        sched_trace_entry_t *entry = &_ring[(head - numof + i) & (SCHED_TRACE_SIZE - 1)];
+        printf("trace: %08lx %u %u %u\n", (unsigned long)entry->time,
+               (unsigned)entry->event, (unsigned)entry->pid,
+               (unsigned)entry->arg);
+    }
+
+    puts("trace: end");
+
+    _enabled = enabled;
+}
@@ -15,6 +15,9 @@
 
 #include <stdio.h>
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+#include "net/gnrc/ipv6/dcache.h"
+#endif
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif.h"
 #include "net/ipv6/addr.h"
@@ -23,6 +26,9 @@ static void _usage(char **argv);
 static int _nib_neigh(int argc, char **argv);
 static int _nib_prefix(int argc, char **argv);
 static int _nib_route(int argc, char **argv);
+#ifdef MODULE_GNRC_IPV6_DCACHE
+static int _nib_dcache(int argc, char **argv);
+#endif
 
 int _gnrc_ipv6_nib(int argc, char **argv)
 {
@@ -41,6 +47,11 @@ int _gnrc_ipv6_nib(int argc, char **argv)
     else if (strcmp(argv[1], "route") == 0) {
         res = _nib_route(argc, argv);
     }
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    else if (strcmp(argv[1], "dcache") == 0) {
+        res = _nib_dcache(argc, argv);
+    }
+#endif
     else {
         _usage(argv);
     }
@@ -49,7 +60,11 @@ int _gnrc_ipv6_nib(int argc, char **argv)
 
 static void _usage(char **argv)
 {
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    printf("usage: %s {neigh|prefix|route|dcache|help} ...\n", argv[0]);
+#else
     printf("usage: %s {neigh|prefix|route|help} ...\n", argv[0]);
+#endif
 }
 
 static void _usage_nib_neigh(char **argv)
@@ -78,6 +93,13 @@ static void _usage_nib_route(char **argv)
     printf("       %s %s show [iface]\n", argv[0], argv[1]);
 }
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+static void _usage_nib_dcache(char **argv)
+{
+    printf("usage: %s %s [show|flush|help]\n", argv[0], argv[1]);
+}
+#endif
+
 static int _nib_neigh(int argc, char **argv)
 {
     if ((argc == 2) || (strcmp(argv[2], "show") == 0)) {
@@ -245,4 +267,24 @@ static int _nib_route(int argc, char **argv)
     return 0;
 }
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+static int _nib_dcache(int argc, char **argv)
+{
+    if ((argc == 2) || (strcmp(argv[2], "show") == 0)) {
+        gnrc_ipv6_dcache_print();
+    }
+    else if (strcmp(argv[2], "help") == 0) {
+        _usage_nib_dcache(argv);
+    }
+    else if (strcmp(argv[2], "flush") == 0) {
+        gnrc_ipv6_dcache_flush();
+    }
+    else {
+        _usage_nib_dcache(argv);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
 /** @} */
@@ -132,12 +132,36 @@ static int _netif_stats(kernel_pid_t iface, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+#ifdef MODULE_GNRC_NETIF_POLL
+        if ((module == NETSTATS_LAYER2) && (stats->rx_wakeups > 0)) {
+            printf("            RX wakeups %u (%u.%02u frames per wakeup)\n",
+                   (unsigned) stats->rx_wakeups,
+                   (unsigned) (stats->rx_count / stats->rx_wakeups),
+                   (unsigned) (((stats->rx_count % stats->rx_wakeups) * 100) /
+                               stats->rx_wakeups));
+        }
+#endif
         res = 0;
     }
     return res;
 }
 #endif // MODULE_NETSTATS
 
+#ifdef MODULE_GNRC_NETIF_TXQ
+static void _netif_txq(kernel_pid_t iface)
+{
+    gnrc_netif_t *netif = gnrc_netif_get_by_pid(iface);
+    gnrc_netif_txq_stats_t *stats = &netif->txq.stats;
+
+    printf("          TX queue %u/%u (max: %u)\n"
+           "            queued %u  dropped %u  ECN marked %u  timeouts %u\n",
+           (unsigned) netif->txq.len, (unsigned) GNRC_NETIF_TXQ_SIZE,
+           (unsigned) stats->max_len, (unsigned) stats->queued,
+           (unsigned) stats->dropped, (unsigned) stats->marked,
+           (unsigned) stats->timeouts);
+}
+#endif
+
 static void _set_usage(char *cmd_name)
 {
     printf("usage: %s <if_id> set <key> <value>\n", cmd_name);
@@ -165,6 +189,9 @@ static void _set_usage(char *cmd_name)
          "       * \"cr\" - alias for coding rate\n"
          "       * \"power\" - TX power in dBm\n"
          "       * \"retrans\" - max. number of retransmissions\n"
+#ifdef MODULE_GNRC_NETIF_POLL
+         "       * \"rx_budget\" - max. number of frames handled per wakeup\n"
+#endif
          "       * \"src_len\" - sets the source address length in byte\n"
          "       * \"state\" - set the device state\n");
 }
@@ -276,6 +303,10 @@ static void _print_netopt(netopt_t opt)
             printf("coding rate");
             break;
 
+        case NETOPT_RX_BUDGET:
+            printf("RX budget");
+            break;
+
         default:
             /* we don't serve these options here */
             break;
@@ -482,6 +513,13 @@ static void _netif_list(kernel_pid_t iface)
                                    line_thresh);
     line_thresh = _netif_list_flag(iface, NETOPT_CHANNEL_HOP, "CHAN_HOP",
                                    line_thresh);
+#ifdef MODULE_GNRC_NETIF_POLL
+    res = gnrc_netapi_get(iface, NETOPT_RX_BUDGET, 0, &u16, sizeof(u16));
+    if (res > 0) {
+        printf("RX_BUDGET:%" PRIu16 "  ", u16);
+        line_thresh++;
+    }
+#endif
 #ifdef MODULE_GNRC_IPV6
     res = gnrc_netapi_get(iface, NETOPT_MAX_PACKET_SIZE, GNRC_NETTYPE_IPV6, &u16, sizeof(u16));
     if (res > 0) {
@@ -570,6 +608,9 @@ static void _netif_list(kernel_pid_t iface)
 #endif
 #ifdef MODULE_NETSTATS_IPV6
     _netif_stats(iface, NETSTATS_IPV6, false);
+#endif
+#ifdef MODULE_GNRC_NETIF_TXQ
+    _netif_txq(iface);
 #endif
     puts("");
 }
@@ -1026,6 +1067,11 @@ static int _netif_set(char *cmd_name, kernel_pid_t iface, char *key, char *value
     else if (strcmp("retrans", key) == 0) {
         return _netif_set_u8(iface, NETOPT_RETRANS, 0, value);
     }
+#ifdef MODULE_GNRC_NETIF_POLL
+    else if (strcmp("rx_budget", key) == 0) {
+        return _netif_set_u16(iface, NETOPT_RX_BUDGET, 0, value);
+    }
+#endif
     else if (strcmp("src_len", key) == 0) {
         return _netif_set_u16(iface, NETOPT_SRC_LEN, 0, value);
     }
@@ -0,0 +1,118 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for packet buffer statistics
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+
+static const char *_nettype_str(gnrc_nettype_t type)
+{
+    switch (type) {
+        case GNRC_NETTYPE_IOVEC:
+            return "iovec";
+        case GNRC_NETTYPE_NETIF:
+            return "netif";
+        case GNRC_NETTYPE_UNDEF:
+            return "undef";
+#ifdef MODULE_GNRC_SIXLOWPAN
+        case GNRC_NETTYPE_SIXLOWPAN:
+            return "6lowpan";
+#endif
+#ifdef MODULE_GNRC_GOMACH
+        case GNRC_NETTYPE_GOMACH:
+            return "gomach";
+#endif
+#ifdef MODULE_GNRC_LWMAC
+        case GNRC_NETTYPE_LWMAC:
+            return "lwmac";
+#endif
+#ifdef MODULE_GNRC_IPV6
+        case GNRC_NETTYPE_IPV6:
+            return "ipv6";
+#endif
+#ifdef MODULE_GNRC_IPV6_EXT
+        case GNRC_NETTYPE_IPV6_EXT:
+            return "ipv6_ext";
+#endif
+#ifdef MODULE_GNRC_ICMPV6
+        case GNRC_NETTYPE_ICMPV6:
+            return "icmpv6";
+#endif
+#ifdef MODULE_GNRC_TCP
+        case GNRC_NETTYPE_TCP:
+            return "tcp";
+#endif
+#ifdef MODULE_GNRC_UDP
+        case GNRC_NETTYPE_UDP:
+            return "udp";
+#endif
+#ifdef MODULE_CCN_LITE
+        case GNRC_NETTYPE_CCN:
+            return "ccn";
+        case GNRC_NETTYPE_CCN_CHUNK:
+            return "ccn_chunk";
+#endif
+#ifdef TEST_SUITES
+        case GNRC_NETTYPE_TEST:
+            return "test";
+#endif
+        default:
+            return "?";
+    }
+}
+
+int _gnrc_pktbuf_cmd(int argc, char **argv)
+{
+    gnrc_pktbuf_stats_t stats;
+    size_t bytes = 0;
+    unsigned snips = 0;
+    uint32_t fails = 0;
+
+    if ((argc > 2) || ((argc == 2) && (strcmp(argv[1], "-v") != 0))) {
+        printf("usage: %s [-v]\n", argv[0]);
+        puts("       -v also lists types that never used the packet buffer");
+        return 1;
+    }
+    gnrc_pktbuf_get_stats(&stats);
+    if (stats.size > 0) {
+        printf("packet buffer: %u of %u bytes used, largest free: %u bytes "
+               "(fragmentation: %u%%)\n", (unsigned)stats.used,
+               (unsigned)stats.size, (unsigned)stats.largest_free,
+               gnrc_pktbuf_stats_frag(&stats));
+    }
+    else {
+        printf("packet buffer: %u bytes used on the heap\n", (unsigned)stats.used);
+    }
+    printf("%-10s %6s %8s %6s %8s\n", "type", "snips", "bytes", "max", "failed");
+    for (int type = GNRC_NETTYPE_IOVEC; type < GNRC_NETTYPE_NUMOF; type++) {
+        const gnrc_pktbuf_type_stats_t *entry = gnrc_pktbuf_stats_type(&stats, type);
+
+        bytes += entry->bytes;
+        snips += entry->snips;
+        fails += entry->fails;
+        if ((argc < 2) && (entry->max_snips == 0) && (entry->fails == 0)) {
+            continue;
+        }
+        printf("%-10s %6u %8u %6u %8lu\n", _nettype_str(type),
+               (unsigned)entry->snips, (unsigned)entry->bytes,
+               (unsigned)entry->max_snips, (unsigned long)entry->fails);
+    }
+    printf("%-10s %6u %8u %6s %8lu\n", "total", snips, (unsigned)bytes, "",
+           (unsigned long)fails);
+    return 0;
+}
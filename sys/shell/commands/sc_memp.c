@@ -0,0 +1,27 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for memory pool statistics
+ *
+ * @}
+ */
+
+#include "memp.h"
+
+int _memp_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    memp_print_stats();
+
+    return 0;
+}
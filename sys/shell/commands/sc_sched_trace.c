@@ -0,0 +1,47 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the scheduler trace
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sched_trace.h"
+
+int _sched_trace_handler(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("usage: %s <start|stop|clear|dump>\n", argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "start") == 0) {
+        sched_trace_start();
+    }
+    else if (strcmp(argv[1], "stop") == 0) {
+        sched_trace_stop();
+    }
+    else if (strcmp(argv[1], "clear") == 0) {
+        sched_trace_clear();
+    }
+    else if (strcmp(argv[1], "dump") == 0) {
+        sched_trace_dump();
+    }
+    else {
+        printf("usage: %s <start|stop|clear|dump>\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
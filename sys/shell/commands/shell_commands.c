@@ -84,6 +84,10 @@ extern int _random_get(int argc, char **argv);
 extern int _gnrc_ipv6_nib(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_STATS
+extern int _gnrc_pktbuf_cmd(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_NETIF
 extern int _gnrc_netif_config(int argc, char **argv);
 #ifdef MODULE_GNRC_TXTSND
@@ -138,6 +142,14 @@ extern int _ls_handler(int argc, char **argv);
 extern int _can_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_SCHED_TRACE
+extern int _sched_trace_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_CORE_MEMP
+extern int _memp_handler(int argc, char **argv);
+#endif
+
 const shell_command_t _shell_command_list[] = {
     {"reboot", "Reboot the node", _reboot_handler},
 #ifdef MODULE_CONFIG
@@ -184,6 +196,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_GNRC_IPV6_NIB
     {"nib", "Configure neighbor information base", _gnrc_ipv6_nib},
 #endif
+#ifdef MODULE_GNRC_PKTBUF_STATS
+    {"pktbuf", "Prints packet buffer usage per type ('pktbuf [-v]')", _gnrc_pktbuf_cmd},
+#endif
 #ifdef MODULE_GNRC_NETIF
     {"ifconfig", "Configure network interfaces", _gnrc_netif_config},
 #ifdef MODULE_GNRC_TXTSND
@@ -225,6 +240,12 @@ const shell_command_t _shell_command_list[] = {
 #endif
 #ifdef MODULE_CONN_CAN
     {"can", "CAN commands", _can_handler},
+#endif
+#ifdef MODULE_SCHED_TRACE
+    {"trace", "Start, stop, clear or dump the scheduler trace", _sched_trace_handler},
+#endif
+#ifdef MODULE_CORE_MEMP
+    {"memp", "Prints memory pool statistics", _memp_handler},
 #endif
     {NULL, NULL, NULL}
 };
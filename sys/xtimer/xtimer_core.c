@@ -41,11 +41,23 @@ static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
+#ifdef MODULE_XTIMER_SLACK
+/* time the low-level timer is set to for the current timer list */
+static uint32_t _list_deadline = 0;
+static xtimer_stats_t _stats;
+#endif
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
+static void _set(xtimer_t *timer, uint32_t offset);
+static int _set_absolute(xtimer_t *timer, uint32_t target);
 static inline void _lltimer_set(uint32_t target);
+static void _lltimer_set_list(void);
+#ifdef MODULE_XTIMER_SLACK
+static inline uint32_t _latest(xtimer_t *timer);
+#endif
 static uint32_t _time_left(uint32_t target, uint32_t reference);
 
 static void _timer_callback(void);
@@ -58,6 +70,16 @@ static inline int _is_set(xtimer_t *timer)
     return (timer->target || timer->long_target);
 }
 
+static inline void _set_slack(xtimer_t *timer, uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = slack;
+#else
+    (void)timer;
+    (void)slack;
+#endif
+}
+
 static inline void xtimer_spin_until(uint32_t target) {
 #if XTIMER_MASK
     target = _xtimer_lltimer_mask(target);
@@ -102,6 +124,7 @@ uint64_t _xtimer_now64(void)
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 {
     DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    _set_slack(timer, 0);
     if (!long_offset) {
         /* timer fits into the short timer */
         _xtimer_set(timer, (uint32_t) offset);
@@ -127,6 +150,18 @@ void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 }
 
 void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _set_slack(timer, 0);
+    _set(timer, offset);
+}
+
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    _set_slack(timer, slack);
+    _set(timer, offset);
+}
+
+static void _set(xtimer_t *timer, uint32_t offset)
 {
     DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
           offset, xtimer_now().ticks32, _xtimer_lltimer_now());
@@ -143,7 +178,7 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
     else {
         uint32_t target = _xtimer_now() + offset;
-        _xtimer_set_absolute(timer, target);
+        _set_absolute(timer, target);
     }
 }
 
@@ -169,6 +204,12 @@ static inline void _lltimer_set(uint32_t target)
 }
 
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    _set_slack(timer, 0);
+    return _set_absolute(timer, target);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target)
 {
     uint32_t now = _xtimer_now();
     int res = 0;
@@ -209,8 +250,14 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
             if (timer_list_head == timer) {
                 DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
-                _lltimer_set(target - XTIMER_OVERHEAD);
+                _lltimer_set_list();
+            }
+#ifdef MODULE_XTIMER_SLACK
+            else if (_latest(timer) < _list_deadline) {
+                DEBUG("timer_set_absolute(): timer shortens deadline. updating lltimer.\n");
+                _lltimer_set_list();
             }
+#endif
         }
     }
 
@@ -219,6 +266,63 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
+#ifdef MODULE_XTIMER_SLACK
+/**
+ * @brief latest time a timer may expire, not leaving the current period
+ */
+static inline uint32_t _latest(xtimer_t *timer)
+{
+    uint32_t latest = timer->target + timer->slack;
+
+    if ((latest < timer->target) || !_this_high_period(latest)) {
+        return timer->target;
+    }
+    return latest;
+}
+
+/**
+ * @brief get the time the low-level timer needs to fire for timer_list_head
+ *
+ * This is the earliest time any timer of the list may expire at the latest.
+ * All timers with a target before that time are expired by that interrupt,
+ * so the walk is bounded by the number of timers expiring together.
+ */
+static uint32_t _get_list_deadline(void)
+{
+    uint32_t deadline = _latest(timer_list_head);
+
+    for (xtimer_t *timer = timer_list_head->next;
+         timer && (timer->target < deadline); timer = timer->next) {
+        uint32_t latest = _latest(timer);
+        if (latest < deadline) {
+            deadline = latest;
+        }
+    }
+
+    return deadline;
+}
+
+void xtimer_get_stats(xtimer_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+#endif
+
+/**
+ * @brief set low-level timer for the current timer list's head
+ */
+static void _lltimer_set_list(void)
+{
+#ifdef MODULE_XTIMER_SLACK
+    _list_deadline = _get_list_deadline();
+    _lltimer_set(_list_deadline - XTIMER_OVERHEAD);
+#else
+    _lltimer_set(timer_list_head->target - XTIMER_OVERHEAD);
+#endif
+}
+
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -257,16 +361,14 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
 static void _remove(xtimer_t *timer)
 {
     if (timer_list_head == timer) {
-        uint32_t next;
         timer_list_head = timer->next;
         if (timer_list_head) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            _lltimer_set_list();
         }
         else {
-            next = _xtimer_lltimer_mask(0xFFFFFFFF);
+            _lltimer_set(_xtimer_lltimer_mask(0xFFFFFFFF));
         }
-        _lltimer_set(next);
     }
     else {
         if (!_remove_timer_from_list(&timer_list_head, timer)) {
@@ -432,6 +534,9 @@ static void _timer_callback(void)
 {
     uint32_t next_target;
     uint32_t reference;
+#ifdef MODULE_XTIMER_SLACK
+    unsigned fired = 0;
+#endif
 
     _in_handler = 1;
 
@@ -480,6 +585,9 @@ overflow:
 
         /* fire timer */
         _shoot(timer);
+#ifdef MODULE_XTIMER_SLACK
+        fired++;
+#endif
     }
 
     /* possibly executing all callbacks took enough
@@ -496,7 +604,12 @@ overflow:
 
     if (timer_list_head) {
         /* schedule callback on next timer target time */
+#ifdef MODULE_XTIMER_SLACK
+        _list_deadline = _get_list_deadline();
+        next_target = _list_deadline - XTIMER_OVERHEAD;
+#else
         next_target = timer_list_head->target - XTIMER_OVERHEAD;
+#endif
 
         /* make sure we're not setting a time in the past */
         if (next_target < (_xtimer_lltimer_now() + XTIMER_ISR_BACKOFF)) {
@@ -527,6 +640,13 @@ overflow:
         }
     }
 
+#ifdef MODULE_XTIMER_SLACK
+    if (fired) {
+        _stats.wakeups++;
+        _stats.merged += fired - 1;
+    }
+#endif
+
     _in_handler = 0;
 
     /* set low level timer */
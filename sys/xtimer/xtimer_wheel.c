@@ -0,0 +1,657 @@
+/**
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality, hierarchical timing wheel backend
+ *
+ * This is a drop-in replacement for xtimer_core.c. Instead of keeping timers
+ * in sorted lists, every timer is put into a slot of a hierarchical timing
+ * wheel. Level 0 slots are one tick wide, every further level is
+ * 2^XTIMER_WHEEL_LEVEL_BITS times coarser than the one below.
+ *
+ * A timer is placed relative to the wheel's reference time (_base): its level
+ * is given by the most significant digit in which its 64bit target differs
+ * from _base, its slot by the value of that digit. As all targets are >= _base,
+ * every timer on a lower level expires before any timer on a higher level, and
+ * within one level the slot number follows the expiry order. The earliest
+ * non-empty slot is thus found by scanning the per-level occupancy bitmaps.
+ *
+ * When the start of a slot on a level > 0 is reached, _base is advanced to it
+ * and the slot's timers are re-inserted ("cascaded") into lower levels. Each
+ * timer is cascaded at most XTIMER_WHEEL_LEVELS - 1 times, so insertion and
+ * removal are O(1) and the amortized work in the ISR is O(1) per timer.
+ *
+ * Timers further away than the wheel's span are kept in an unsorted list that
+ * is redistributed once per wheel revolution.
+ * @}
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define WHEEL_SLOTS         (1U << XTIMER_WHEEL_LEVEL_BITS)
+#define WHEEL_SLOT_MASK     (WHEEL_SLOTS - 1)
+#define WHEEL_SPAN_BITS     (XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_LEVEL_BITS)
+
+#if (WHEEL_SPAN_BITS > 32) || (WHEEL_SPAN_BITS < 16)
+#error "XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_LEVEL_BITS must be within 16..32"
+#endif
+#if ((UINT_MAX >> (WHEEL_SLOTS - 1)) == 0)
+#error "XTIMER_WHEEL_LEVEL_BITS too large for the occupancy bitmap"
+#endif
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/* low-level timer value seen during the last period check */
+static uint32_t _ll_last = 0;
+
+/* low-level timer value the timer is currently armed for */
+static uint32_t _armed_ll = 0;
+
+/* reference time of the wheel, always <= the earliest timer's target */
+static uint64_t _base = 0;
+
+/* time the low-level timer is currently armed for */
+static uint64_t _armed = UINT64_MAX;
+
+static xtimer_t *_slots[XTIMER_WHEEL_LEVELS][WHEEL_SLOTS];
+static unsigned _occupied[XTIMER_WHEEL_LEVELS];
+static xtimer_t *_far_list = NULL;
+
+#ifdef MODULE_XTIMER_SLACK
+/* maximum number of timers inspected when looking for a common deadline */
+#define SLACK_SCAN_MAX      (16U)
+
+static xtimer_stats_t _stats;
+#endif
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+static void _set(xtimer_t *timer, uint32_t offset);
+static int _set_absolute(xtimer_t *timer, uint32_t target);
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline uint64_t _key(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+/**
+ * @brief latest time a timer may expire
+ */
+static inline uint64_t _latest(xtimer_t *timer)
+{
+#ifdef MODULE_XTIMER_SLACK
+    return _key(timer) + timer->slack;
+#else
+    return _key(timer);
+#endif
+}
+
+static inline void _set_slack(xtimer_t *timer, uint32_t slack)
+{
+#ifdef MODULE_XTIMER_SLACK
+    timer->slack = slack;
+#else
+    (void)timer;
+    (void)slack;
+#endif
+}
+
+static inline void xtimer_spin_until(uint32_t target) {
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target);
+    while (_xtimer_lltimer_now() < target);
+}
+
+static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t before, after, long_value;
+
+    /* loop to cope with possible overflow of _xtimer_now() */
+    do {
+        before = _xtimer_now();
+        long_value = _long_cnt;
+        after = _xtimer_now();
+
+    } while(before > after);
+
+    *short_term = after;
+    *long_term = long_value;
+}
+
+uint64_t _xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now_internal(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+/**
+ * @brief last tick of the current low-level timer period
+ */
+static inline uint64_t _period_end(void)
+{
+#if XTIMER_MASK
+    uint32_t high = _xtimer_high_cnt;
+#else
+    uint32_t high = 0;
+#endif
+    return ((uint64_t)_long_cnt << 32) | high | _xtimer_lltimer_mask(0xFFFFFFFF);
+}
+
+/**
+ * @brief advance to the next low-level timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+}
+
+/**
+ * @brief detect low-level timer overflows (ISR context only)
+ *
+ * The low-level timer is never armed later than the end of the current
+ * period, so this is called at least once per period.
+ */
+static void _update_period(void)
+{
+    uint32_t now = _xtimer_lltimer_now();
+    int wrapped = (now < _ll_last);
+
+    if (now == _xtimer_lltimer_mask(0xFFFFFFFF)) {
+        /* make sure the timer counter also arrived in the next period */
+        while ((now = _xtimer_lltimer_now()) == _xtimer_lltimer_mask(0xFFFFFFFF)) {}
+        wrapped = 1;
+    }
+    if (wrapped) {
+        _next_period();
+    }
+    _ll_last = now;
+}
+
+/**
+ * @brief current 64bit time (ISR context only)
+ */
+static uint64_t _isr_now64(void)
+{
+    _update_period();
+    return ((uint64_t)_long_cnt << 32) | _xtimer_now();
+}
+
+static void _arm(uint64_t deadline)
+{
+    uint64_t end = _period_end();
+    uint32_t target;
+
+    if (deadline >= end) {
+        /* register overflow tick */
+        _armed = end;
+        target = (uint32_t)end;
+    }
+    else {
+        _armed = deadline;
+        target = (uint32_t)deadline - XTIMER_OVERHEAD;
+    }
+    _armed_ll = _xtimer_lltimer_mask(target);
+    DEBUG("_arm(): setting %" PRIu32 "\n", _armed_ll);
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _armed_ll);
+}
+
+/**
+ * @brief mixed into xtimer_t::link_check, never a timer address since it
+ *        is not aligned
+ */
+#define LINK_CHECK_MAGIC    ((uintptr_t)0xa5a5a5a5U)
+
+static inline uintptr_t _link_check(xtimer_t *timer, xtimer_t **pprev)
+{
+    return (uintptr_t)pprev ^ (uintptr_t)timer ^ LINK_CHECK_MAGIC;
+}
+
+static inline void _set_pprev(xtimer_t *timer, xtimer_t **pprev)
+{
+    timer->pprev = pprev;
+    timer->link_check = _link_check(timer, pprev);
+}
+
+/**
+ * @brief check whether @p timer is linked into the wheel
+ *
+ * Timers on the stack are commonly removed without ever being set, so their
+ * fields may hold anything. timer->pprev is only followed if it was set by
+ * the wheel, i.e. if xtimer_t::link_check matches it, which garbage does
+ * only by chance. Unlinking a timer clears timer->pprev, so timers that were
+ * removed or fired are never followed either.
+ */
+static inline int _in_wheel(xtimer_t *timer)
+{
+    return (timer->pprev != NULL) &&
+           (timer->link_check == _link_check(timer, timer->pprev)) &&
+           (*timer->pprev == timer);
+}
+
+static void _wheel_add(xtimer_t *timer)
+{
+    uint64_t key = _key(timer);
+    xtimer_t **head;
+
+    if (key < _base) {
+        /* target already passed, expire with the current level 0 slot */
+        key = _base;
+    }
+
+    uint64_t diff = key ^ _base;
+    if (diff >> WHEEL_SPAN_BITS) {
+        head = &_far_list;
+    }
+    else {
+        uint32_t digits = (uint32_t)diff;
+        unsigned level = 0;
+        while (digits >> XTIMER_WHEEL_LEVEL_BITS) {
+            digits >>= XTIMER_WHEEL_LEVEL_BITS;
+            level++;
+        }
+        unsigned slot = (unsigned)(key >> (level * XTIMER_WHEEL_LEVEL_BITS)) &
+                        WHEEL_SLOT_MASK;
+        head = &_slots[level][slot];
+        _occupied[level] |= (1U << slot);
+    }
+
+    timer->next = *head;
+    if (*head) {
+        _set_pprev(*head, &timer->next);
+    }
+    _set_pprev(timer, head);
+    *head = timer;
+}
+
+static void _wheel_del(xtimer_t *timer)
+{
+    xtimer_t **head = timer->pprev;
+
+    if (!_in_wheel(timer)) {
+        /* not in the wheel (anymore) */
+        return;
+    }
+
+    *head = timer->next;
+    if (timer->next) {
+        _set_pprev(timer->next, head);
+    }
+    timer->next = NULL;
+    timer->pprev = NULL;
+
+    /* clear occupancy bit if timer was the last one of a slot */
+    uintptr_t first = (uintptr_t)&_slots[0][0];
+    uintptr_t pos = (uintptr_t)head;
+    if (!*head && (pos >= first) && (pos < (first + sizeof(_slots)))) {
+        unsigned idx = (pos - first) / sizeof(xtimer_t *);
+        _occupied[idx / WHEEL_SLOTS] &= ~(1U << (idx % WHEEL_SLOTS));
+    }
+}
+
+/**
+ * @brief find the earliest non-empty wheel slot
+ *
+ * @return 0 if the wheel is empty
+ */
+static int _first_slot(unsigned *level, unsigned *slot)
+{
+    for (unsigned i = 0; i < XTIMER_WHEEL_LEVELS; i++) {
+        if (_occupied[i]) {
+            *level = i;
+            *slot = bitarithm_lsb(_occupied[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline uint64_t _slot_start(unsigned level, unsigned slot)
+{
+    unsigned shift = level * XTIMER_WHEEL_LEVEL_BITS;
+    uint64_t upper = (_base >> (shift + XTIMER_WHEEL_LEVEL_BITS)) <<
+                     (shift + XTIMER_WHEEL_LEVEL_BITS);
+    return upper | ((uint64_t)slot << shift);
+}
+
+/**
+ * @brief start of the next wheel revolution
+ */
+static inline uint64_t _next_revolution(void)
+{
+    return (_base | ((((uint64_t)1) << WHEEL_SPAN_BITS) - 1)) + 1;
+}
+
+#ifdef MODULE_XTIMER_SLACK
+/**
+ * @brief get the latest time the next timer interrupt may happen
+ *
+ * Walks the wheel in expiry order as long as slots start before the earliest
+ * deadline seen so far, so all timers expiring before that deadline are
+ * handled by one interrupt. If the walk is cut short, the deadline is capped
+ * to the start of the slot that was not completely inspected.
+ */
+static uint64_t _get_deadline(void)
+{
+    uint64_t deadline = UINT64_MAX;
+    unsigned budget = SLACK_SCAN_MAX;
+
+    for (unsigned level = 0; level < XTIMER_WHEEL_LEVELS; level++) {
+        unsigned occupied = _occupied[level];
+        while (occupied) {
+            unsigned slot = bitarithm_lsb(occupied);
+            uint64_t start = _slot_start(level, slot);
+            if (start >= deadline) {
+                return deadline;
+            }
+            occupied &= ~(1U << slot);
+            for (xtimer_t *timer = _slots[level][slot]; timer; timer = timer->next) {
+                if (!budget--) {
+                    return start;
+                }
+                if (_latest(timer) < deadline) {
+                    deadline = _latest(timer);
+                }
+            }
+        }
+    }
+
+    if (_far_list && (_next_revolution() < deadline)) {
+        deadline = _next_revolution();
+    }
+    return deadline;
+}
+
+void xtimer_get_stats(xtimer_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _stats;
+    irq_restore(state);
+}
+#endif
+
+/**
+ * @brief move all timers of @p list into the wheel again, relative to _base
+ */
+static void _redistribute(xtimer_t *list)
+{
+    while (list) {
+        xtimer_t *timer = list;
+        list = timer->next;
+        _wheel_add(timer);
+    }
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    /* register initial overflow tick */
+    _arm(UINT64_MAX);
+}
+
+static void _add(xtimer_t *timer)
+{
+    _wheel_add(timer);
+
+    if (!_in_handler && (_latest(timer) < _armed)) {
+        DEBUG("xtimer: timer is new earliest deadline. updating lltimer.\n");
+        _arm(_latest(timer));
+    }
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    _set_slack(timer, 0);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        _xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+        if (_is_set(timer)) {
+            _wheel_del(timer);
+        }
+
+        _xtimer_now_internal(&timer->target, &timer->long_target);
+        timer->target += offset;
+        timer->long_target += long_offset;
+        if (timer->target < offset) {
+            timer->long_target++;
+        }
+
+        _add(timer);
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void _xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    _set_slack(timer, 0);
+    _set(timer, offset);
+}
+
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    _set_slack(timer, slack);
+    _set(timer, offset);
+}
+
+static void _set(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n",
+          offset, xtimer_now().ticks32, _xtimer_lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        _xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        uint32_t target = _xtimer_now() + offset;
+        _set_absolute(timer, target);
+    }
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    _set_slack(timer, 0);
+    return _set_absolute(timer, target);
+}
+
+static int _set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = _xtimer_now();
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    if (_is_set(timer)) {
+        _wheel_del(timer);
+    }
+
+    timer->target = target;
+    timer->long_target = _long_cnt;
+    if (target < now) {
+        timer->long_target++;
+    }
+
+    _add(timer);
+    irq_restore(state);
+
+    return 0;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _wheel_del(timer);
+    }
+    irq_restore(state);
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+#ifdef MODULE_XTIMER_SLACK
+    unsigned fired = 0;
+#endif
+
+    _in_handler = 1;
+
+    /* the low-level timer does not fire before the value it was armed for,
+     * so reading a smaller value means that it overflowed in the meantime */
+    _ll_last = _armed_ll;
+
+    while (1) {
+        uint64_t now = _isr_now64();
+        uint64_t next;
+        unsigned level, slot;
+        int in_wheel = _first_slot(&level, &slot);
+
+        if (in_wheel) {
+            next = _slot_start(level, slot);
+            if (level && !_slots[level][slot]->next) {
+                /* single timer in a coarse slot, don't wake up before its
+                 * target just to cascade it */
+                next = _key(_slots[level][slot]);
+            }
+        }
+        else if (_far_list) {
+            next = _next_revolution();
+        }
+        else {
+            next = UINT64_MAX;
+        }
+
+        if (next > (now + XTIMER_ISR_BACKOFF)) {
+#ifdef MODULE_XTIMER_SLACK
+            if (in_wheel) {
+                next = _get_deadline();
+            }
+#endif
+            uint64_t end = _period_end();
+            if ((next < end) || (end > (now + XTIMER_ISR_BACKOFF))) {
+                _arm(next);
+                break;
+            }
+            /* end of this period is very soon, spin until next period */
+            while (_isr_now64() <= end) {}
+            continue;
+        }
+
+        if (!in_wheel) {
+            /* wheel is empty, start next revolution. If the wheel was idle
+             * for several revolutions, skip them instead of walking them. */
+            xtimer_t *list = _far_list;
+            _far_list = NULL;
+            _base = (now > next) ? now : next;
+            _redistribute(list);
+        }
+        else if (level) {
+            /* cascade slot into lower levels */
+            xtimer_t *list = _slots[level][slot];
+            _slots[level][slot] = NULL;
+            _occupied[level] &= ~(1U << slot);
+            _base = _slot_start(level, slot);
+            _redistribute(list);
+        }
+        else {
+            /* make sure we don't fire too early */
+            _base = next;
+            while (_isr_now64() < next) {}
+
+            xtimer_t *timer = _slots[0][slot];
+            _wheel_del(timer);
+
+            /* make sure timer is recognized as being already fired */
+            timer->target = 0;
+            timer->long_target = 0;
+
+            _shoot(timer);
+#ifdef MODULE_XTIMER_SLACK
+            fired++;
+#endif
+        }
+    }
+
+#ifdef MODULE_XTIMER_SLACK
+    if (fired) {
+        _stats.wakeups++;
+        _stats.merged += fired - 1;
+    }
+#endif
+
+    _in_handler = 0;
+}
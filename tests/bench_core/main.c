@@ -0,0 +1,286 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Micro-benchmarks for the kernel primitives
+ *
+ * Every benchmark prints one JSON line with the throughput and the 50th
+ * and 99th percentile and maximum of the per-operation latency. The
+ * throughput is timed over TEST_SAMPLES * TEST_BATCH back-to-back
+ * operations, the percentiles over TEST_SAMPLES operations that are timed
+ * one by one. A single latency sample includes one xtimer_now() call and
+ * is only as precise as the resolution of xtimer.
+ *
+ * Where a benchmark involves a second thread, that thread has a higher
+ * priority than main, so one operation is a full round trip through the
+ * scheduler.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "event.h"
+#include "mbox.h"
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifndef TEST_SAMPLES
+#define TEST_SAMPLES        (256U)
+#endif
+
+#ifndef TEST_BATCH
+#define TEST_BATCH          (32U)
+#endif
+
+#define HELPER_PRIO         (THREAD_PRIORITY_MAIN - 1)
+#define FLAG_GO             (0x0001)
+#define MBOX_SIZE           (8U)
+
+typedef void (*bench_op_t)(void);
+
+static uint32_t _samples[TEST_SAMPLES];
+
+static char _stack_yield[THREAD_STACKSIZE_DEFAULT];
+static char _stack_msg[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mbox[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mutex[THREAD_STACKSIZE_DEFAULT];
+static char _stack_flags[THREAD_STACKSIZE_DEFAULT];
+static char _stack_event[THREAD_STACKSIZE_DEFAULT];
+
+static kernel_pid_t _helper;
+static volatile int _yield_running;
+
+static msg_t _mbox_queue[MBOX_SIZE];
+static mbox_t _mbox = MBOX_INIT(_mbox_queue, MBOX_SIZE);
+
+static mutex_t _mutex = MUTEX_INIT;
+
+static event_queue_t _queue;
+
+static void _event_handler(event_t *event)
+{
+    (void)event;
+}
+
+static event_t _event = { .handler = _event_handler };
+
+static int _cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* ticks for one call of an operation to ns per operation */
+static uint32_t _ns_per_op(uint32_t ticks, unsigned ops_per_call)
+{
+    uint64_t ns = ((uint64_t)ticks * US_PER_SEC * NS_PER_US) / XTIMER_HZ;
+
+    return (uint32_t)(ns / ops_per_call);
+}
+
+/**
+ * @brief   Run @p op TEST_SAMPLES * TEST_BATCH times for the throughput and
+ *          TEST_SAMPLES times for the latency and print the result
+ *
+ * @param[in] name          name of the benchmark
+ * @param[in] op            operation to measure
+ * @param[in] ops_per_call  number of operations a single call of @p op counts as
+ */
+static void _bench(const char *name, bench_op_t op, unsigned ops_per_call)
+{
+    uint32_t start, total;
+
+    start = xtimer_now().ticks32;
+    for (unsigned i = 0; i < (TEST_SAMPLES * TEST_BATCH); i++) {
+        op();
+    }
+    total = xtimer_now().ticks32 - start;
+
+    for (unsigned i = 0; i < TEST_SAMPLES; i++) {
+        start = xtimer_now().ticks32;
+        op();
+        _samples[i] = xtimer_now().ticks32 - start;
+    }
+
+    qsort(_samples, TEST_SAMPLES, sizeof(_samples[0]), _cmp);
+
+    uint64_t ops = (uint64_t)TEST_SAMPLES * TEST_BATCH * ops_per_call;
+    uint64_t usec = ((uint64_t)total * US_PER_SEC) / XTIMER_HZ;
+    uint32_t ops_per_sec = usec ? (uint32_t)((ops * US_PER_SEC) / usec) : 0;
+
+    printf("{\"bench\":\"%s\",\"board\":\"%s\",\"ops\":%lu,"
+           "\"ops_per_sec\":%lu,\"p50_ns\":%lu,\"p99_ns\":%lu,\"max_ns\":%lu}\n",
+           name, RIOT_BOARD, (unsigned long)ops, (unsigned long)ops_per_sec,
+           (unsigned long)_ns_per_op(_samples[TEST_SAMPLES / 2], ops_per_call),
+           (unsigned long)_ns_per_op(_samples[(TEST_SAMPLES * 99) / 100],
+                                     ops_per_call),
+           (unsigned long)_ns_per_op(_samples[TEST_SAMPLES - 1], ops_per_call));
+}
+
+static kernel_pid_t _start(char *stack, size_t size, uint8_t prio,
+                           thread_task_func_t func, const char *name)
+{
+    return thread_create(stack, size, prio, THREAD_CREATE_STACKTEST, func,
+                         NULL, name);
+}
+
+/* context switch: main and a thread of the same priority yield to each other,
+ * every thread_yield() in main is two switches */
+static void *_yield_thread(void *arg)
+{
+    (void)arg;
+    while (_yield_running) {
+        thread_yield();
+    }
+    return NULL;
+}
+
+static void _op_yield(void)
+{
+    thread_yield();
+}
+
+/* msg_send_receive() to a thread replying immediately */
+static void *_msg_thread(void *arg)
+{
+    (void)arg;
+    msg_t m;
+    while (1) {
+        msg_receive(&m);
+        msg_reply(&m, &m);
+    }
+    return NULL;
+}
+
+static void _op_msg(void)
+{
+    msg_t m, reply;
+    m.type = 0;
+    msg_send_receive(&m, &reply, _helper);
+}
+
+/* mbox_put() to a thread waiting in mbox_get() */
+static void *_mbox_thread(void *arg)
+{
+    (void)arg;
+    msg_t m;
+    while (1) {
+        mbox_get(&_mbox, &m);
+    }
+    return NULL;
+}
+
+static void _op_mbox(void)
+{
+    msg_t m;
+    m.type = 0;
+    mbox_put(&_mbox, &m);
+}
+
+/* uncontended mutex_lock()/mutex_unlock() pair */
+static void _op_mutex_uncontended(void)
+{
+    mutex_lock(&_mutex);
+    mutex_unlock(&_mutex);
+}
+
+/* main holds the mutex while the helper blocks on it, then hands it over */
+static void *_mutex_thread(void *arg)
+{
+    (void)arg;
+    while (1) {
+        thread_flags_wait_any(FLAG_GO);
+        mutex_lock(&_mutex);
+        mutex_unlock(&_mutex);
+    }
+    return NULL;
+}
+
+static void _op_mutex_contended(void)
+{
+    mutex_lock(&_mutex);
+    thread_flags_set((thread_t *)thread_get(_helper), FLAG_GO);
+    mutex_unlock(&_mutex);
+}
+
+/* thread_flags_set() to a thread waiting in thread_flags_wait_any() */
+static void *_flags_thread(void *arg)
+{
+    (void)arg;
+    while (1) {
+        thread_flags_wait_any(FLAG_GO);
+    }
+    return NULL;
+}
+
+static void _op_flags(void)
+{
+    thread_flags_set((thread_t *)thread_get(_helper), FLAG_GO);
+}
+
+/* event_post() to a thread running event_loop() */
+static void *_event_thread(void *arg)
+{
+    (void)arg;
+    event_queue_init(&_queue);
+    event_loop(&_queue);
+    return NULL;
+}
+
+static void _op_event(void)
+{
+    event_post(&_queue, &_event);
+}
+
+int main(void)
+{
+    puts("kernel micro-benchmarks");
+
+    _yield_running = 1;
+    _start(_stack_yield, sizeof(_stack_yield), THREAD_PRIORITY_MAIN,
+           _yield_thread, "yield");
+    _bench("context_switch", _op_yield, 2);
+    _yield_running = 0;
+    thread_yield();
+
+    _helper = _start(_stack_msg, sizeof(_stack_msg), HELPER_PRIO,
+                     _msg_thread, "msg");
+    _bench("msg_send_receive", _op_msg, 1);
+
+    _start(_stack_mbox, sizeof(_stack_mbox), HELPER_PRIO, _mbox_thread,
+           "mbox");
+    _bench("mbox_put_get", _op_mbox, 1);
+
+    _bench("mutex_uncontended", _op_mutex_uncontended, 1);
+
+    _helper = _start(_stack_mutex, sizeof(_stack_mutex), HELPER_PRIO,
+                     _mutex_thread, "mutex");
+    _bench("mutex_contended", _op_mutex_contended, 1);
+
+    _helper = _start(_stack_flags, sizeof(_stack_flags), HELPER_PRIO,
+                     _flags_thread, "flags");
+    _bench("thread_flags", _op_flags, 1);
+
+    _start(_stack_event, sizeof(_stack_event), HELPER_PRIO, _event_thread,
+           "event");
+    _bench("event_post", _op_event, 1);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import os
+import sys
+
+BENCHMARKS = ("context_switch", "msg_send_receive", "mbox_put_get",
+              "mutex_uncontended", "mutex_contended", "thread_flags",
+              "event_post")
+
+
+def testfunc(child):
+    child.expect_exact("kernel micro-benchmarks")
+    for name in BENCHMARKS:
+        child.expect(r"(\{[^\r\n]*\})\r?\n")
+        result = json.loads(child.match.group(1))
+        assert result["bench"] == name
+        assert result["ops_per_sec"] > 0
+        assert result["p50_ns"] <= result["p99_ns"] <= result["max_ns"]
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,89 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures gnrc_netreg_lookup() for a growing number of
+ *              registrations
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (1024U)
+#endif
+
+#define NUMOF_MAX           (64U)
+#define DEMUX_CTX           (0x1000U)
+#define MSG_QUEUE_SIZE      (4U)
+
+#ifdef MODULE_GNRC_NETREG_HASH
+#define REGISTRY            "hash"
+#else
+#define REGISTRY            "linear"
+#endif
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _entries[NUMOF_MAX];
+
+static int _bench(unsigned numof)
+{
+    unsigned found = 0;
+    uint32_t start, duration;
+
+    gnrc_netreg_init();
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_entry_init_pid(&_entries[i], DEMUX_CTX + i,
+                                   thread_getpid());
+        if (gnrc_netreg_register(GNRC_NETTYPE_TEST, &_entries[i]) != 0) {
+            return 0;
+        }
+    }
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        unsigned idx = i % numof;
+
+        if (gnrc_netreg_lookup(GNRC_NETTYPE_TEST, DEMUX_CTX + idx) ==
+            &_entries[idx]) {
+            found++;
+        }
+    }
+    duration = xtimer_now_usec() - start;
+    printf("{\"bench\":\"netreg_lookup\",\"registry\":\"%s\","
+           "\"registrations\":%u,\"lookups\":%u,\"us\":%" PRIu32 "}\n",
+           REGISTRY, numof, TEST_LOOKUPS, duration);
+    return (found == TEST_LOOKUPS);
+}
+
+int main(void)
+{
+    static const unsigned numofs[] = { 1, 8, 32, NUMOF_MAX };
+
+    /* only threads with a message queue may register */
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    puts("gnrc_netreg lookup benchmark");
+    for (unsigned i = 0; i < (sizeof(numofs) / sizeof(numofs[0])); i++) {
+        if (!_bench(numofs[i])) {
+            puts("[FAILED]");
+            return 1;
+        }
+    }
+    puts("[SUCCESS]");
+
+    return 0;
+}
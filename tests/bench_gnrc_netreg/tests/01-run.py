@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import json
+import os
+import sys
+
+REGISTRATIONS = (1, 8, 32, 64)
+
+
+def testfunc(child):
+    child.expect_exact("gnrc_netreg lookup benchmark")
+    for numof in REGISTRATIONS:
+        child.expect(r"(\{[^\r\n]*\})\r?\n")
+        result = json.loads(child.match.group(1))
+        assert result["bench"] == "netreg_lookup"
+        assert result["registrations"] == numof
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
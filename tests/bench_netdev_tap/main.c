@@ -0,0 +1,356 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       UDP packet rate benchmark over native's TAP interface
+ *
+ * `udpsink <port>` counts the UDP packets arriving at a port and
+ * `udpsink stats` prints the packet and bit rate since the first of them.
+ * `udpgen <addr> <port> <size> <seconds>` sends UDP packets as fast as
+ * possible.  `udpecho <port>` returns every UDP packet arriving at a port to
+ * its sender, to measure the round-trip time.  The host side counterpart is
+ * `udpgen.py`.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#ifdef MODULE_NETDEV_TAP_MQ
+#include "netdev_tap.h"
+#endif
+
+#define MAIN_QUEUE_SIZE     (8)
+#define SINK_QUEUE_SIZE     (32)
+#define SINK_MSG_STATS      (0x8f00)
+
+typedef struct {
+    uint32_t packets;
+    uint32_t bytes;
+    uint32_t first;
+    uint32_t last;
+} sink_stats_t;
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static msg_t _sink_queue[SINK_QUEUE_SIZE];
+static char _sink_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _sink_pid = KERNEL_PID_UNDEF;
+static gnrc_netreg_entry_t _sink_entry = GNRC_NETREG_ENTRY_INIT_PID(0, KERNEL_PID_UNDEF);
+static msg_t _echo_queue[SINK_QUEUE_SIZE];
+static char _echo_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _echo_pid = KERNEL_PID_UNDEF;
+static gnrc_netreg_entry_t _echo_entry = GNRC_NETREG_ENTRY_INIT_PID(0, KERNEL_PID_UNDEF);
+
+static void _print_rate(const char *dir, uint32_t packets, uint32_t bytes,
+                        uint32_t usec, uint32_t failed)
+{
+    uint64_t pps = usec ? ((uint64_t)packets * US_PER_SEC) / usec : 0;
+    uint64_t kbps = usec ? ((uint64_t)bytes * 8 * MS_PER_SEC) / usec : 0;
+
+    printf("%s: packets=%lu bytes=%lu time=%lu us pps=%lu kbit/s=%lu failed=%lu\n",
+           dir, (unsigned long)packets, (unsigned long)bytes,
+           (unsigned long)usec, (unsigned long)pps, (unsigned long)kbps,
+           (unsigned long)failed);
+}
+
+static void *_sink(void *arg)
+{
+    (void)arg;
+    sink_stats_t stats;
+    msg_t msg;
+
+    memset(&stats, 0, sizeof(stats));
+    msg_init_queue(_sink_queue, SINK_QUEUE_SIZE);
+
+    while (1) {
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                uint32_t now = xtimer_now_usec();
+
+                if (stats.packets == 0) {
+                    stats.first = now;
+                }
+                stats.last = now;
+                stats.packets++;
+                stats.bytes += gnrc_pkt_len(pkt);
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case SINK_MSG_STATS:
+                _print_rate("rx", stats.packets, stats.bytes,
+                            stats.last - stats.first, 0);
+                memset(&stats, 0, sizeof(stats));
+                break;
+            default:
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+static int _udpsink_cmd(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("usage: %s <port>|stats\n", argv[0]);
+        return 1;
+    }
+
+    if (_sink_pid == KERNEL_PID_UNDEF) {
+        _sink_pid = thread_create(_sink_stack, sizeof(_sink_stack),
+                                  THREAD_PRIORITY_MAIN - 1,
+                                  THREAD_CREATE_STACKTEST, _sink, NULL,
+                                  "udpsink");
+    }
+
+    if (strcmp(argv[1], "stats") == 0) {
+        msg_t msg = { .type = SINK_MSG_STATS };
+        msg_send(&msg, _sink_pid);
+        return 0;
+    }
+
+    uint16_t port = atoi(argv[1]);
+    if (port == 0) {
+        puts("error: invalid port");
+        return 1;
+    }
+    if (_sink_entry.target.pid != KERNEL_PID_UNDEF) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &_sink_entry);
+    }
+    gnrc_netreg_entry_init_pid(&_sink_entry, port, _sink_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &_sink_entry);
+    printf("udpsink: listening on port %u\n", (unsigned)port);
+    return 0;
+}
+
+static void _echo_reply(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6, *udp, *netif, *reply, *tmp;
+
+    ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+    netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    if ((ipv6 == NULL) || (udp == NULL) || (netif == NULL)) {
+        return;
+    }
+
+    reply = gnrc_pktbuf_add(NULL, pkt->data, pkt->size, GNRC_NETTYPE_UNDEF);
+    if (reply == NULL) {
+        return;
+    }
+    tmp = gnrc_udp_hdr_build(reply,
+                             byteorder_ntohs(((udp_hdr_t *)udp->data)->dst_port),
+                             byteorder_ntohs(((udp_hdr_t *)udp->data)->src_port));
+    if (tmp == NULL) {
+        gnrc_pktbuf_release(reply);
+        return;
+    }
+    reply = tmp;
+    tmp = gnrc_ipv6_hdr_build(reply, NULL, &((ipv6_hdr_t *)ipv6->data)->src);
+    if (tmp == NULL) {
+        gnrc_pktbuf_release(reply);
+        return;
+    }
+    reply = tmp;
+    tmp = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (tmp == NULL) {
+        gnrc_pktbuf_release(reply);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)tmp->data)->if_pid =
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid;
+    LL_PREPEND(reply, tmp);
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP,
+                                   GNRC_NETREG_DEMUX_CTX_ALL, reply)) {
+        gnrc_pktbuf_release(reply);
+    }
+}
+
+static void *_echo(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+
+    msg_init_queue(_echo_queue, SINK_QUEUE_SIZE);
+
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            _echo_reply(msg.content.ptr);
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+
+    return NULL;
+}
+
+static int _udpecho_cmd(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("usage: %s <port>\n", argv[0]);
+        return 1;
+    }
+
+    uint16_t port = atoi(argv[1]);
+    if (port == 0) {
+        puts("error: invalid port");
+        return 1;
+    }
+    if (_echo_pid == KERNEL_PID_UNDEF) {
+        _echo_pid = thread_create(_echo_stack, sizeof(_echo_stack),
+                                  THREAD_PRIORITY_MAIN - 1,
+                                  THREAD_CREATE_STACKTEST, _echo, NULL,
+                                  "udpecho");
+    }
+    if (_echo_entry.target.pid != KERNEL_PID_UNDEF) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &_echo_entry);
+    }
+    gnrc_netreg_entry_init_pid(&_echo_entry, port, _echo_pid);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &_echo_entry);
+    printf("udpecho: listening on port %u\n", (unsigned)port);
+    return 0;
+}
+
+static int _udpgen_cmd(int argc, char **argv)
+{
+    ipv6_addr_t addr;
+    int iface;
+
+    if (argc != 5) {
+        printf("usage: %s <addr> <port> <size> <seconds>\n", argv[0]);
+        return 1;
+    }
+
+    iface = ipv6_addr_split_iface(argv[1]);
+    if ((iface < 0) && (gnrc_netif_numof() == 1)) {
+        iface = gnrc_netif_iter(NULL)->pid;
+    }
+    if (ipv6_addr_from_str(&addr, argv[1]) == NULL) {
+        puts("error: unable to parse destination address");
+        return 1;
+    }
+    uint16_t port = atoi(argv[2]);
+    size_t size = atoi(argv[3]);
+    uint32_t duration = atoi(argv[4]) * US_PER_SEC;
+    if ((port == 0) || (size == 0)) {
+        puts("error: invalid port or size");
+        return 1;
+    }
+
+    uint32_t packets = 0, bytes = 0, failed = 0;
+    uint32_t start = xtimer_now_usec();
+    uint32_t now = start;
+
+    while ((now - start) < duration) {
+        gnrc_pktsnip_t *payload, *udp, *ip;
+
+        payload = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+        if (payload == NULL) {
+            /* packet buffer full, give the stack time to drain it */
+            failed++;
+            thread_yield();
+            now = xtimer_now_usec();
+            continue;
+        }
+        memset(payload->data, (uint8_t)packets, size);
+        udp = gnrc_udp_hdr_build(payload, port, port);
+        if (udp == NULL) {
+            failed++;
+            gnrc_pktbuf_release(payload);
+            now = xtimer_now_usec();
+            continue;
+        }
+        ip = gnrc_ipv6_hdr_build(udp, NULL, &addr);
+        if (ip == NULL) {
+            failed++;
+            gnrc_pktbuf_release(udp);
+            now = xtimer_now_usec();
+            continue;
+        }
+        if (iface > 0) {
+            gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+            if (netif == NULL) {
+                failed++;
+                gnrc_pktbuf_release(ip);
+                now = xtimer_now_usec();
+                continue;
+            }
+            ((gnrc_netif_hdr_t *)netif->data)->if_pid = (kernel_pid_t)iface;
+            LL_PREPEND(ip, netif);
+        }
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, ip)) {
+            puts("error: unable to locate UDP thread");
+            gnrc_pktbuf_release(ip);
+            return 1;
+        }
+        packets++;
+        bytes += size;
+        now = xtimer_now_usec();
+    }
+
+    _print_rate("tx", packets, bytes, now - start, failed);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "udpsink", "count UDP packets on a port or print the rate", _udpsink_cmd },
+    { "udpgen", "send UDP packets as fast as possible", _udpgen_cmd },
+    { "udpecho", "return UDP packets on a port to their sender", _udpecho_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+
+    puts("netdev_tap packet rate benchmark");
+#ifdef MODULE_NETDEV_TAP_MQ
+    printf("rx path: batched, %u queues\n", (unsigned)NETDEV_TAP_QUEUES);
+#elif defined(MODULE_NETDEV_TAP_BATCH)
+    puts("rx path: batched");
+#else
+    puts("rx path: one frame per signal");
+#endif
+#ifdef MODULE_GNRC_NETIF_POLL
+    printf("rx wakeups: polled, budget %u frames\n",
+           (unsigned)GNRC_NETIF_RX_BUDGET);
+#else
+    puts("rx wakeups: one per interrupt");
+#endif
+#ifdef MODULE_GNRC_NETAPI_INLINE
+    puts("stack: run-to-completion");
+#else
+    puts("stack: thread per layer");
+#endif
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
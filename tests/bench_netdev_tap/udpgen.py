@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Host side of the netdev_tap packet rate benchmark.
+
+`send` floods a RIOT node with UDP packets for a given time, `sink` counts
+the packets a RIOT node sends with `udpgen`, and `ping` measures the
+round-trip time to a RIOT node running `udpecho`.
+"""
+
+import argparse
+import socket
+import time
+
+
+def _report(direction, packets, size, seconds):
+    pps = packets / seconds if seconds else 0
+    print("{}: packets={} bytes={} time={:.3f} s pps={:.0f} kbit/s={:.0f}"
+          .format(direction, packets, packets * size, seconds, pps,
+                  pps * size * 8 / 1000))
+
+
+def send(args):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    dest = socket.getaddrinfo(args.addr, args.port, socket.AF_INET6,
+                              socket.SOCK_DGRAM)[0][4]
+    payload = bytes(args.size)
+    packets = 0
+    start = time.monotonic()
+    end = start + args.seconds
+    while time.monotonic() < end:
+        for _ in range(64):
+            try:
+                sock.sendto(payload, dest)
+                packets += 1
+            except BlockingIOError:
+                pass
+    _report("tx", packets, args.size, time.monotonic() - start)
+
+
+def sink(args):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    sock.bind(("::", args.port))
+    sock.settimeout(1)
+    packets = 0
+    size = 0
+    first = last = None
+    end = time.monotonic() + args.seconds
+    while time.monotonic() < end:
+        try:
+            data = sock.recv(65536)
+        except socket.timeout:
+            continue
+        last = time.monotonic()
+        if first is None:
+            first = last
+        packets += 1
+        size = len(data)
+    _report("rx", packets, size, (last - first) if first else 0)
+
+
+def ping(args):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_DGRAM)
+    dest = socket.getaddrinfo(args.addr, args.port, socket.AF_INET6,
+                              socket.SOCK_DGRAM)[0][4]
+    sock.settimeout(1)
+    payload = bytes(args.size)
+    rtts = []
+    lost = 0
+    for _ in range(args.count):
+        start = time.monotonic()
+        sock.sendto(payload, dest)
+        try:
+            sock.recv(65536)
+        except socket.timeout:
+            lost += 1
+            continue
+        rtts.append((time.monotonic() - start) * 1000000)
+    if not rtts:
+        print("rtt: no replies, lost={}".format(lost))
+        return
+    rtts.sort()
+    print("rtt: count={} lost={} min={:.0f} us median={:.0f} us "
+          "p99={:.0f} us max={:.0f} us"
+          .format(len(rtts), lost, rtts[0], rtts[len(rtts) // 2],
+                  rtts[(len(rtts) * 99) // 100], rtts[-1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    sub = parser.add_subparsers(dest="cmd")
+    sub.required = True
+    p = sub.add_parser("send", help="send UDP packets to a RIOT node")
+    p.add_argument("addr", help="destination, e.g. fe80::...%%tap0")
+    p.add_argument("port", type=int)
+    p.add_argument("size", type=int, help="UDP payload size")
+    p.add_argument("seconds", type=float)
+    p.set_defaults(func=send)
+    p = sub.add_parser("sink", help="count UDP packets sent by a RIOT node")
+    p.add_argument("port", type=int)
+    p.add_argument("seconds", type=float)
+    p.set_defaults(func=sink)
+    p = sub.add_parser("ping", help="measure the round-trip time to udpecho")
+    p.add_argument("addr", help="destination, e.g. fe80::...%%tap0")
+    p.add_argument("port", type=int)
+    p.add_argument("size", type=int, help="UDP payload size")
+    p.add_argument("count", type=int)
+    p.set_defaults(func=ping)
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
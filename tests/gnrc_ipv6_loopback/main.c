@@ -0,0 +1,151 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests packets that @ref net_gnrc_ipv6 sends to one of the
+ *              node's own addresses
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/udp.h"
+#include "net/icmpv6.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (4U)
+#define TIMEOUT             (100U * US_PER_MS)
+#define PORT                (8080U)
+
+/* fd01::1 */
+#define ADDR                { { 0xfd, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 } }
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static const ipv6_addr_t _addr = ADDR;
+
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    (void)netif;
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_mock_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .recv = _mock_netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+/* the device claims to complete checksums of the packets it sends */
+static int _set_tx_csum_offload(netdev_t *dev, const void *value,
+                                size_t value_len)
+{
+    (void)dev;
+    (void)value;
+    return value_len;
+}
+
+/* sends pkt to _addr and waits for it to arrive in the registered thread */
+static void _loopback(gnrc_nettype_t type, uint32_t demux_ctx,
+                      gnrc_pktsnip_t *pkt)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(demux_ctx,
+                                                           sched_active_pid);
+    msg_t msg;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NOT_NULL((pkt = gnrc_ipv6_hdr_build(pkt, NULL, &_addr)));
+    gnrc_netreg_register(type, &entry);
+    TEST_ASSERT(gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6,
+                                          GNRC_NETREG_DEMUX_CTX_ALL, pkt) > 0);
+    /* a packet with an invalid checksum is dropped */
+    TEST_ASSERT_EQUAL_INT(1, xtimer_msg_receive_timeout(&msg, TIMEOUT));
+    gnrc_netreg_unregister(type, &entry);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+    gnrc_pktbuf_release(msg.content.ptr);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_loopback__icmpv6(void)
+{
+    _loopback(GNRC_NETTYPE_ICMPV6, ICMPV6_ECHO_REP,
+              gnrc_icmpv6_build(NULL, ICMPV6_ECHO_REP, 0,
+                                sizeof(icmpv6_echo_t)));
+}
+
+static void test_loopback__udp(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add(NULL, "test", sizeof("test"),
+                                              GNRC_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(payload);
+    _loopback(GNRC_NETTYPE_UDP, PORT, gnrc_udp_hdr_build(payload, PORT, PORT));
+}
+
+static Test *tests_gnrc_ipv6_loopback(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_loopback__icmpv6),
+        new_TestFixture(test_loopback__udp),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, NULL, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_set_cb(&_dev, NETOPT_TX_CHECKSUM_OFFLOAD,
+                           _set_tx_csum_offload);
+    _netif = gnrc_netif_create(_stack, sizeof(_stack), GNRC_NETIF_PRIO,
+                               "offload", (netdev_t *)&_dev, &_mock_ops);
+    if (!(_netif->flags & GNRC_NETIF_FLAGS_TX_CSUM_OFFLOAD) ||
+        (gnrc_netif_ipv6_addr_add_internal(_netif, &_addr, 64U,
+                                           GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) < 0)) {
+        puts("error: unable to set up interface");
+        return 1;
+    }
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_ipv6_loopback());
+    TESTS_END();
+
+    return 0;
+}
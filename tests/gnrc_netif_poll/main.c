@@ -0,0 +1,257 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the polled receive path of @ref net_gnrc_netif
+ *              (module `gnrc_netif_poll`)
+ *
+ * The interface's thread has a lower priority than main, so RX events
+ * main triggers pile up while the thread is scheduled but not running yet.
+ * Frames can also arrive while the thread handles a frame, as if the
+ * device raised an interrupt during the poll.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#define LOG_SIZE        (32U)
+#define MSG_TYPE_TEST   (0x7e57)
+#define IDLE_WAIT       (10U * US_PER_MS)
+
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+/* what happened in the interface's thread: 'W' starts a wakeup, 'R' is a
+ * received frame, 'M' a message handled in between */
+static char _log[LOG_SIZE + 1];
+static unsigned _log_len;
+static unsigned _isr_calls;
+/* frames the device holds */
+static volatile unsigned _frames;
+/* frames arriving while the thread handles a frame, one each */
+static unsigned _arrivals;
+/* send a message to the interface while it handles the first frame */
+static bool _post_msg;
+
+static void _log_event(char c)
+{
+    if (_log_len < LOG_SIZE) {
+        _log[_log_len++] = c;
+    }
+}
+
+/* a frame arrives at the device and raises an interrupt */
+static void _arrive(void)
+{
+    _frames++;
+    _netif->dev->event_callback(_netif->dev, NETDEV_EVENT_ISR);
+}
+
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    (void)netif;
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_mock_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    _log_event('R');
+    if (_post_msg) {
+        msg_t msg = { .type = MSG_TYPE_TEST };
+
+        _post_msg = false;
+        msg_send_to_self(&msg);
+    }
+    if (_arrivals > 0) {
+        _arrivals--;
+        _arrive();
+    }
+    return NULL;
+}
+
+static void _mock_netif_msg_handler(gnrc_netif_t *netif, msg_t *msg)
+{
+    (void)netif;
+    if (msg->type == MSG_TYPE_TEST) {
+        _log_event('M');
+    }
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .recv = _mock_netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+    .msg_handler = _mock_netif_msg_handler,
+};
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+/* handles the frames the device held when the thread called it */
+static void _isr(netdev_t *dev)
+{
+    unsigned frames = _frames;
+
+    _isr_calls++;
+    if (_netif->rx_frames == 0) {
+        _log_event('W');
+    }
+    while (frames--) {
+        _frames--;
+        dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+    }
+}
+
+static void _set_rx_budget(uint16_t budget)
+{
+    TEST_ASSERT_EQUAL_INT(sizeof(budget),
+                          gnrc_netapi_set(_netif->pid, NETOPT_RX_BUDGET, 0,
+                                          &budget, sizeof(budget)));
+}
+
+static void set_up(void)
+{
+    memset(_log, 0, sizeof(_log));
+    _log_len = 0;
+    _isr_calls = 0;
+    _arrivals = 0;
+    _post_msg = false;
+    memset(&_netif->dev->stats, 0, sizeof(_netif->dev->stats));
+}
+
+static void tear_down(void)
+{
+    _set_rx_budget(GNRC_NETIF_RX_BUDGET);
+}
+
+static void test_rx_budget(void)
+{
+    uint16_t budget = 0;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(budget),
+                          gnrc_netapi_get(_netif->pid, NETOPT_RX_BUDGET, 0,
+                                          &budget, sizeof(budget)));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_RX_BUDGET, budget);
+    budget = 0;
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          gnrc_netapi_set(_netif->pid, NETOPT_RX_BUDGET, 0,
+                                          &budget, sizeof(budget)));
+    _set_rx_budget(3);
+    TEST_ASSERT_EQUAL_INT(sizeof(budget),
+                          gnrc_netapi_get(_netif->pid, NETOPT_RX_BUDGET, 0,
+                                          &budget, sizeof(budget)));
+    TEST_ASSERT_EQUAL_INT(3, budget);
+}
+
+static void test_poll__events_while_scheduled(void)
+{
+    _arrive();
+    _arrive();
+    _arrive();
+    /* the thread did not run yet */
+    TEST_ASSERT_EQUAL_INT(0, _log_len);
+    xtimer_usleep(IDLE_WAIT);
+    /* one wakeup handled all three frames */
+    TEST_ASSERT_EQUAL_STRING("WRRR", (const char *)_log);
+    TEST_ASSERT_EQUAL_INT(1, _isr_calls);
+    TEST_ASSERT_EQUAL_INT(1, _netif->dev->stats.rx_wakeups);
+    TEST_ASSERT_EQUAL_INT(0, _frames);
+}
+
+static void test_poll__events_while_polling(void)
+{
+    _arrivals = 3;
+    _arrive();
+    xtimer_usleep(IDLE_WAIT);
+    /* the device is polled again for every frame arriving meanwhile */
+    TEST_ASSERT_EQUAL_STRING("WRRRR", (const char *)_log);
+    TEST_ASSERT_EQUAL_INT(4, _isr_calls);
+    TEST_ASSERT_EQUAL_INT(1, _netif->dev->stats.rx_wakeups);
+    TEST_ASSERT_EQUAL_INT(4, _netif->rx_frames);
+    TEST_ASSERT_EQUAL_INT(0, _frames);
+}
+
+static void test_poll__budget_exhausted(void)
+{
+    _set_rx_budget(4);
+    _arrivals = 9;
+    _post_msg = true;
+    _arrive();
+    xtimer_usleep(IDLE_WAIT);
+    /* after 4 frames the thread re-posts the RX event behind the message
+     * queued in the meantime */
+    TEST_ASSERT_EQUAL_STRING("WRRRRMWRRRRWRR", (const char *)_log);
+    TEST_ASSERT_EQUAL_INT(3, _netif->dev->stats.rx_wakeups);
+    TEST_ASSERT_EQUAL_INT(2, _netif->rx_frames);
+    TEST_ASSERT_EQUAL_INT(0, _frames);
+}
+
+static void test_poll__unmasked_after_poll(void)
+{
+    _arrive();
+    xtimer_usleep(IDLE_WAIT);
+    _arrive();
+    _arrive();
+    xtimer_usleep(IDLE_WAIT);
+    /* RX events wake the thread again once it finished polling */
+    TEST_ASSERT_EQUAL_STRING("WRWRR", (const char *)_log);
+    TEST_ASSERT_EQUAL_INT(2, _netif->dev->stats.rx_wakeups);
+}
+
+static Test *tests_gnrc_netif_poll(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rx_budget),
+        new_TestFixture(test_poll__events_while_scheduled),
+        new_TestFixture(test_poll__events_while_polling),
+        new_TestFixture(test_poll__budget_exhausted),
+        new_TestFixture(test_poll__unmasked_after_poll),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_isr_cb(&_dev, _isr);
+    /* lower priority than main, so RX events pile up while it waits */
+    _netif = gnrc_netif_create(_stack, sizeof(_stack),
+                               THREAD_PRIORITY_MAIN + 1, "poll",
+                               (netdev_t *)&_dev, &_mock_ops);
+    /* let the thread initialize the interface, it sets its PID */
+    xtimer_usleep(IDLE_WAIT);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_netif_poll());
+    TESTS_END();
+
+    return 0;
+}
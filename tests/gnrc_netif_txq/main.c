@@ -0,0 +1,239 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the transmission queue of @ref net_gnrc_netif
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/netdev_test.h"
+#include "xtimer.h"
+
+#define SENT_NUMOF      (16U)
+
+static netdev_test_t _async_dev, _sync_dev;
+static gnrc_netif_t *_async_netif, *_sync_netif;
+static char _async_stack[THREAD_STACKSIZE_DEFAULT];
+static char _sync_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _sent[SENT_NUMOF];
+static unsigned _sent_numof;
+
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    (void)netif;
+    if (_sent_numof < SENT_NUMOF) {
+        _sent[_sent_numof++] = *((uint8_t *)pkt->data);
+    }
+    gnrc_pktbuf_release(pkt);
+    return 1;
+}
+
+static gnrc_pktsnip_t *_mock_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .recv = _mock_netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_UNKNOWN;
+    return sizeof(uint16_t);
+}
+
+static int _set_tx_end_irq(netdev_t *dev, const void *value, size_t value_len)
+{
+    (void)dev;
+    (void)value;
+    return value_len;
+}
+
+static int _set_state(netdev_t *dev, const void *value, size_t value_len)
+{
+    (void)dev;
+    (void)value;
+    return value_len;
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_TX_COMPLETE);
+}
+
+/* signals the end of a transmission in the interface's thread */
+static void _tx_complete(gnrc_netif_t *netif)
+{
+    netif->dev->event_callback(netif->dev, NETDEV_EVENT_ISR);
+}
+
+static void _send(gnrc_netif_t *netif, uint8_t id)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, &id, sizeof(id),
+                                          GNRC_NETTYPE_UNDEF);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_send(netif->pid, pkt));
+}
+
+static void set_up(void)
+{
+    /* finish a transmission possibly left by the previous test */
+    _tx_complete(_async_netif);
+    memset(&_async_netif->txq.stats, 0, sizeof(_async_netif->txq.stats));
+    memset(&_sync_netif->txq.stats, 0, sizeof(_sync_netif->txq.stats));
+    _sent_numof = 0;
+}
+
+static void test_send__no_tx_end_irq(void)
+{
+    for (uint8_t i = 0; i < 3; i++) {
+        _send(_sync_netif, i);
+    }
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _sync_netif->txq.len);
+    TEST_ASSERT_EQUAL_INT(0, _sync_netif->txq.stats.queued);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_send__queued_until_tx_complete(void)
+{
+    for (uint8_t i = 0; i < 3; i++) {
+        _send(_async_netif, i);
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(2, _async_netif->txq.len);
+    TEST_ASSERT_EQUAL_INT(2, _async_netif->txq.stats.queued);
+    _tx_complete(_async_netif);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    _tx_complete(_async_netif);
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+    _tx_complete(_async_netif);
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _sent[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _async_netif->txq.len);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_send__queue_full(void)
+{
+    /* one in transmission, GNRC_NETIF_TXQ_SIZE queued, one dropped */
+    for (uint8_t i = 0; i < (GNRC_NETIF_TXQ_SIZE + 2); i++) {
+        _send(_async_netif, i);
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _async_netif->txq.len);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE, _async_netif->txq.stats.max_len);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE,
+                          _async_netif->txq.stats.queued);
+    TEST_ASSERT_EQUAL_INT(1, _async_netif->txq.stats.dropped);
+    for (unsigned i = 0; i < GNRC_NETIF_TXQ_SIZE; i++) {
+        _tx_complete(_async_netif);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_NETIF_TXQ_SIZE + 1, _sent_numof);
+    for (uint8_t i = 0; i < (GNRC_NETIF_TXQ_SIZE + 1); i++) {
+        TEST_ASSERT_EQUAL_INT(i, _sent[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _async_netif->txq.len);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_send__state_change(void)
+{
+    netopt_state_t state = NETOPT_STATE_IDLE;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        _send(_async_netif, i);
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    /* e.g. a reset aborts the transmission without the device reporting it */
+    TEST_ASSERT_EQUAL_INT(sizeof(state), gnrc_netapi_set(_async_netif->pid,
+                                                         NETOPT_STATE, 0,
+                                                         &state,
+                                                         sizeof(state)));
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(1, _async_netif->txq.len);
+    _tx_complete(_async_netif);
+    TEST_ASSERT_EQUAL_INT(3, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _async_netif->txq.stats.timeouts);
+}
+
+static void test_send__timeout(void)
+{
+    for (uint8_t i = 0; i < 2; i++) {
+        _send(_async_netif, i);
+    }
+    TEST_ASSERT_EQUAL_INT(1, _sent_numof);
+    /* the device never reports the end of the transmission; wake up before
+     * the transmission of the second packet times out as well */
+    xtimer_usleep((3 * GNRC_NETIF_TXQ_TX_TIMEOUT) / 2);
+    TEST_ASSERT_EQUAL_INT(2, _sent_numof);
+    TEST_ASSERT_EQUAL_INT(0, _async_netif->txq.len);
+    TEST_ASSERT_EQUAL_INT(1, _async_netif->txq.stats.timeouts);
+    _tx_complete(_async_netif);
+    /* no timeout after a reported end */
+    xtimer_usleep(2 * GNRC_NETIF_TXQ_TX_TIMEOUT);
+    TEST_ASSERT_EQUAL_INT(1, _async_netif->txq.stats.timeouts);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_netif_txq(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_send__no_tx_end_irq),
+        new_TestFixture(test_send__queued_until_tx_complete),
+        new_TestFixture(test_send__queue_full),
+        new_TestFixture(test_send__state_change),
+        new_TestFixture(test_send__timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    netdev_test_setup(&_async_dev, NULL);
+    netdev_test_set_get_cb(&_async_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_set_cb(&_async_dev, NETOPT_TX_END_IRQ, _set_tx_end_irq);
+    netdev_test_set_set_cb(&_async_dev, NETOPT_STATE, _set_state);
+    netdev_test_set_isr_cb(&_async_dev, _isr);
+    netdev_test_setup(&_sync_dev, NULL);
+    netdev_test_set_get_cb(&_sync_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    _async_netif = gnrc_netif_create(_async_stack, sizeof(_async_stack),
+                                     GNRC_NETIF_PRIO, "async",
+                                     (netdev_t *)&_async_dev, &_mock_ops);
+    _sync_netif = gnrc_netif_create(_sync_stack, sizeof(_sync_stack),
+                                    GNRC_NETIF_PRIO, "sync",
+                                    (netdev_t *)&_sync_dev, &_mock_ops);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_netif_txq());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sends a fragmented 6LoWPAN datagram through the transmission
+ *              queue of @ref net_gnrc_netif
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+
+/* maximum payload of an IEEE 802.15.4 frame with the largest MAC header */
+#define FRAG_SIZE       (IEEE802154_FRAME_LEN_MAX - IEEE802154_MAX_HDR_LEN - \
+                         IEEE802154_FCS_LEN)
+#define PAYLOAD_SIZE    (IPV6_MIN_MTU - sizeof(ipv6_hdr_t))
+#define DST_L2ADDR      { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 }
+
+static const ipv6_addr_t _src = { .u8 = { 0xfe, 0x80, [15] = 0x01 } };
+static const ipv6_addr_t _dst = { .u8 = { 0xfe, 0x80, [15] = 0x02 } };
+static uint8_t _dst_l2addr[] = DST_L2ADDR;
+
+static netdev_test_t _dev;
+static gnrc_netif_t *_netif;
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static unsigned _frags_numof;
+/* end of the last fragment within the datagram */
+static size_t _end;
+static size_t _datagram_size;
+
+static int _mock_netif_send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    (void)netif;
+    gnrc_pktsnip_t *frag = pkt->next;
+
+    if ((frag != NULL) && sixlowpan_frag_is(frag->data)) {
+        sixlowpan_frag_n_t *hdr = frag->data;
+
+        _frags_numof++;
+        _datagram_size = byteorder_ntohs(hdr->disp_size) &
+                         SIXLOWPAN_FRAG_SIZE_MASK;
+        if ((hdr->disp_size.u8[0] & SIXLOWPAN_FRAG_DISP_MASK) ==
+            SIXLOWPAN_FRAG_N_DISP) {
+            _end = (hdr->offset * 8U) + frag->size - sizeof(*hdr);
+        }
+    }
+    gnrc_pktbuf_release(pkt);
+    return 1;
+}
+
+static gnrc_pktsnip_t *_mock_netif_recv(gnrc_netif_t *netif)
+{
+    (void)netif;
+    return NULL;
+}
+
+static const gnrc_netif_ops_t _mock_ops = {
+    .send = _mock_netif_send,
+    .recv = _mock_netif_recv,
+    .get = gnrc_netif_get_from_netdev,
+    .set = gnrc_netif_set_from_netdev,
+};
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = FRAG_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_src_len(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    *((uint16_t *)value) = IEEE802154_LONG_ADDRESS_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address_long(netdev_t *dev, void *value, size_t max_len)
+{
+    static const uint8_t addr[] = { 0x02, 0x00, 0x00, 0xff,
+                                    0xfe, 0x00, 0x00, 0x01 };
+
+    (void)dev;
+    assert(max_len >= sizeof(addr));
+    memcpy(value, addr, sizeof(addr));
+    return sizeof(addr);
+}
+
+static int _set_tx_end_irq(netdev_t *dev, const void *value, size_t value_len)
+{
+    (void)dev;
+    (void)value;
+    return value_len;
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_TX_COMPLETE);
+}
+
+/* signals the end of a transmission in the interface's thread */
+static void _tx_complete(gnrc_netif_t *netif)
+{
+    netif->dev->event_callback(netif->dev, NETDEV_EVENT_ISR);
+}
+
+static gnrc_pktsnip_t *_build_datagram(void)
+{
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(payload);
+    memset(payload->data, 0xab, payload->size);
+    ipv6 = gnrc_ipv6_hdr_build(payload, &_src, &_dst);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    ((ipv6_hdr_t *)ipv6->data)->len = byteorder_htons(PAYLOAD_SIZE);
+    netif = gnrc_netif_hdr_build(NULL, 0, _dst_l2addr, sizeof(_dst_l2addr));
+    TEST_ASSERT_NOT_NULL(netif);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netif->pid;
+    LL_PREPEND(ipv6, netif);
+    return netif;
+}
+
+static void test_send__fragmented_datagram(void)
+{
+    unsigned queued;
+
+    /* 6LoWPAN hands all fragments to the interface before this returns, as
+     * both threads have a higher priority */
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                                       GNRC_NETREG_DEMUX_CTX_ALL,
+                                                       _build_datagram()));
+    TEST_ASSERT_EQUAL_INT(1, _frags_numof);
+    queued = _netif->txq.len;
+    TEST_ASSERT(queued >= ((IPV6_MIN_MTU / FRAG_SIZE) - 1));
+    TEST_ASSERT(queued < GNRC_NETIF_TXQ_FRAGS_NUMOF);
+    TEST_ASSERT_EQUAL_INT(0, _netif->txq.stats.dropped);
+    for (unsigned i = 0; i <= queued; i++) {
+        _tx_complete(_netif);
+    }
+    TEST_ASSERT_EQUAL_INT(queued + 1, _frags_numof);
+    TEST_ASSERT_EQUAL_INT(0, _netif->txq.len);
+    TEST_ASSERT_EQUAL_INT(IPV6_MIN_MTU, _datagram_size);
+    TEST_ASSERT_EQUAL_INT(IPV6_MIN_MTU, _end);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_netif_txq_frag(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_send__fragmented_datagram),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, NULL, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PACKET_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_SRC_LEN, _get_src_len);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS_LONG, _get_address_long);
+    netdev_test_set_set_cb(&_dev, NETOPT_TX_END_IRQ, _set_tx_end_irq);
+    netdev_test_set_isr_cb(&_dev, _isr);
+    _netif = gnrc_netif_create(_stack, sizeof(_stack), GNRC_NETIF_PRIO,
+                               "wpan", (netdev_t *)&_dev, &_mock_ops);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_netif_txq_frag());
+    TESTS_END();
+
+    return 0;
+}
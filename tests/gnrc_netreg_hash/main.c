@@ -0,0 +1,180 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the hashed registry of module `gnrc_netreg_hash`
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/nettype.h"
+#include "thread.h"
+
+/* more demux contexts than buckets, so at least two of them share one */
+#define CTX_NUMOF       (GNRC_NETREG_HASH_SIZE + 1)
+#define CTX_ENTRIES     (3)
+#define MSG_QUEUE_SIZE  (4)
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _entries[CTX_NUMOF][CTX_ENTRIES];
+
+static void set_up(void)
+{
+    gnrc_netreg_init();
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        for (unsigned i = 0; i < CTX_ENTRIES; i++) {
+            gnrc_netreg_entry_init_pid(&_entries[ctx][i], ctx, thread_getpid());
+        }
+    }
+}
+
+/* registers the first `numof` entries of every demux context, interleaving
+ * the contexts */
+static void _register_all(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+            TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                          &_entries[ctx][i]));
+        }
+    }
+}
+
+/* checks that exactly the entries of `ctx` flagged in `mask` are found */
+static void _check_ctx(uint32_t ctx, unsigned mask)
+{
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, ctx);
+    unsigned found = 0;
+
+    while (entry != NULL) {
+        unsigned i = 0;
+
+        TEST_ASSERT_EQUAL_INT(ctx, entry->demux_ctx);
+        while ((i < CTX_ENTRIES) && (entry != &_entries[ctx][i])) {
+            i++;
+        }
+        TEST_ASSERT(i < CTX_ENTRIES);
+        TEST_ASSERT_EQUAL_INT(0, found & (1U << i));
+        found |= (1U << i);
+        entry = gnrc_netreg_getnext(entry);
+    }
+    TEST_ASSERT_EQUAL_INT(mask, found);
+}
+
+static void test_lookup__empty(void)
+{
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 0));
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(NULL));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_num(GNRC_NETTYPE_TEST, 0));
+}
+
+static void test_lookup__same_ctx(void)
+{
+    for (unsigned i = 0; i < CTX_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &_entries[0][i]));
+    }
+    _check_ctx(0, (1U << CTX_ENTRIES) - 1);
+    TEST_ASSERT_EQUAL_INT(CTX_ENTRIES, gnrc_netreg_num(GNRC_NETTYPE_TEST, 0));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 1));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, 0));
+}
+
+static void test_lookup__colliding_ctx(void)
+{
+    _register_all(CTX_ENTRIES);
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        _check_ctx(ctx, (1U << CTX_ENTRIES) - 1);
+        TEST_ASSERT_EQUAL_INT(CTX_ENTRIES, gnrc_netreg_num(GNRC_NETTYPE_TEST,
+                                                           ctx));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, CTX_NUMOF));
+}
+
+static void test_unregister__same_ctx(void)
+{
+    for (unsigned i = 0; i < CTX_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &_entries[0][i]));
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &_entries[0][1]);
+    _check_ctx(0, 0x5);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &_entries[0][0]);
+    _check_ctx(0, 0x4);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &_entries[0][2]);
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, 0));
+}
+
+static void test_unregister__colliding_ctx(void)
+{
+    _register_all(CTX_ENTRIES);
+    /* remove one entry of every second context and all of the others */
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        if (ctx & 1) {
+            gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &_entries[ctx][ctx % CTX_ENTRIES]);
+        }
+        else {
+            for (unsigned i = 0; i < CTX_ENTRIES; i++) {
+                gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &_entries[ctx][i]);
+            }
+        }
+    }
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        if (ctx & 1) {
+            _check_ctx(ctx, ((1U << CTX_ENTRIES) - 1) & ~(1U << (ctx % CTX_ENTRIES)));
+        }
+        else {
+            TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, ctx));
+        }
+    }
+    /* entries registered again after unregistering are found again */
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx += 2) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                      &_entries[ctx][1]));
+    }
+    for (unsigned ctx = 0; ctx < CTX_NUMOF; ctx++) {
+        if (ctx & 1) {
+            _check_ctx(ctx, ((1U << CTX_ENTRIES) - 1) & ~(1U << (ctx % CTX_ENTRIES)));
+        }
+        else {
+            _check_ctx(ctx, 0x2);
+        }
+    }
+}
+
+static Test *tests_gnrc_netreg_hash(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_lookup__empty),
+        new_TestFixture(test_lookup__same_ctx),
+        new_TestFixture(test_lookup__colliding_ctx),
+        new_TestFixture(test_unregister__same_ctx),
+        new_TestFixture(test_unregister__colliding_ctx),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    /* only threads with a message queue may register */
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_netreg_hash());
+    TESTS_END();
+
+    return 0;
+}
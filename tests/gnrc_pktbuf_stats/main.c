@@ -0,0 +1,140 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the usage statistics of module `gnrc_pktbuf_stats`
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
+
+#define TEST_STRING8    "d)M Fvgh"
+#define TEST_STRING16   "nvxuO*6o3C=a6g7]"
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void test_get_stats__add_release(void)
+{
+    gnrc_pktbuf_stats_t stats;
+    const gnrc_pktbuf_type_stats_t *test;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                          GNRC_NETTYPE_TEST);
+
+    pkt = gnrc_pktbuf_add(pkt, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_get_stats(&stats);
+    test = gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_EQUAL_INT(2, test->snips);
+    TEST_ASSERT_EQUAL_INT(2, test->max_snips);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16) + sizeof(TEST_STRING8), test->bytes);
+    TEST_ASSERT_EQUAL_INT(0, test->fails);
+    TEST_ASSERT(stats.used >= (test->bytes + (2 * sizeof(gnrc_pktsnip_t))));
+
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_get_stats(&stats);
+    test = gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_EQUAL_INT(0, test->snips);
+    TEST_ASSERT_EQUAL_INT(2, test->max_snips);
+    TEST_ASSERT_EQUAL_INT(0, test->bytes);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_get_stats__mark(void)
+{
+    gnrc_pktbuf_stats_t stats;
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                                          GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(gnrc_pktbuf_mark(pkt, 4, GNRC_NETTYPE_UNDEF));
+    /* accounting follows the type the snip was allocated with */
+    pkt->type = GNRC_NETTYPE_UNDEF;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 8));
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST)->snips);
+    TEST_ASSERT_EQUAL_INT(8, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST)->bytes);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_UNDEF)->snips);
+    TEST_ASSERT_EQUAL_INT(4, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_UNDEF)->bytes);
+
+    gnrc_pktbuf_release(pkt);
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST)->bytes);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_UNDEF)->bytes);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_get_stats__fails(void)
+{
+    gnrc_pktbuf_stats_t stats;
+
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SIZE + 1, GNRC_NETTYPE_TEST));
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(1, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST)->fails);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_UNDEF)->fails);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_stats_type(&stats, GNRC_NETTYPE_TEST)->max_snips);
+}
+
+#ifdef MODULE_GNRC_PKTBUF_STATIC
+static void test_get_stats__fragmentation(void)
+{
+    gnrc_pktbuf_stats_t stats;
+    gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, NULL, 64, GNRC_NETTYPE_TEST);
+
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SIZE, stats.size);
+    TEST_ASSERT_EQUAL_INT(stats.size - stats.used, stats.largest_free);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_stats_frag(&stats));
+
+    gnrc_pktbuf_release(pkt2);
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT(stats.largest_free < (stats.size - stats.used));
+    TEST_ASSERT(gnrc_pktbuf_stats_frag(&stats) > 0);
+
+    gnrc_pktbuf_release(pkt1);
+    gnrc_pktbuf_release(pkt3);
+    gnrc_pktbuf_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SIZE, stats.largest_free);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
+static Test *tests_gnrc_pktbuf_stats(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_get_stats__add_release),
+        new_TestFixture(test_get_stats__mark),
+        new_TestFixture(test_get_stats__fails),
+#ifdef MODULE_GNRC_PKTBUF_STATIC
+        new_TestFixture(test_get_stats__fragmentation),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_gnrc_pktbuf_stats());
+    TESTS_END();
+
+    return 0;
+}
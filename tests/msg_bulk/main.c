@@ -0,0 +1,130 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test msg_send_bulk() and msg_receive_bulk()
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+
+#define QUEUE_SIZE      (8U)
+#define BATCH_SIZE      (12U)
+#define BATCHES         (4U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static char _slow_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _queue[QUEUE_SIZE];
+static msg_t _slow_queue[QUEUE_SIZE];
+
+static unsigned _received;
+static unsigned _wakeups;
+static unsigned _slow_calls;
+static int _failed;
+
+static void *_receiver(void *arg)
+{
+    (void)arg;
+    msg_t msgs[BATCH_SIZE];
+
+    msg_init_queue(_queue, QUEUE_SIZE);
+
+    while (1) {
+        int n = msg_receive_bulk(msgs, BATCH_SIZE);
+        _wakeups++;
+        for (int i = 0; i < n; i++) {
+            if (msgs[i].content.value != _received) {
+                printf("unexpected message %lu, expected %u\n",
+                       (unsigned long)msgs[i].content.value, _received);
+                _failed = 1;
+            }
+            _received = msgs[i].content.value + 1;
+        }
+    }
+
+    return NULL;
+}
+
+static void *_slow_receiver(void *arg)
+{
+    msg_t msgs[QUEUE_SIZE / 2];
+    msg_t ready;
+
+    msg_init_queue(_slow_queue, QUEUE_SIZE);
+    msg_send(&ready, (kernel_pid_t)(intptr_t)arg);
+
+    while (1) {
+        /* counted before, as a woken sender runs before this returns */
+        _slow_calls++;
+        msg_receive_bulk(msgs, QUEUE_SIZE / 2);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    msg_t msgs[BATCH_SIZE];
+    unsigned sent = 0;
+
+    puts("msg_send_bulk() / msg_receive_bulk() test");
+
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _receiver, NULL, "receiver");
+
+    for (unsigned b = 0; b < BATCHES; b++) {
+        for (unsigned i = 0; i < BATCH_SIZE; i++) {
+            msgs[i].type = 0;
+            msgs[i].content.value = sent + i;
+        }
+        /* the receiver is waiting, so one message is handed over directly
+         * and QUEUE_SIZE messages are queued */
+        int n = msg_send_bulk(msgs, BATCH_SIZE, pid);
+        printf("batch %u: delivered %d\n", b, n);
+        if (n != (QUEUE_SIZE + 1)) {
+            _failed = 1;
+        }
+        sent += n;
+    }
+
+    printf("sent=%u received=%u wakeups=%u\n", sent, _received, _wakeups);
+    if ((_received != sent) || (_wakeups > (2 * BATCHES))) {
+        _failed = 1;
+    }
+
+    /* the receiver has a lower priority, so the queue fills up and the last
+     * message blocks until the first msg_receive_bulk() makes room for it */
+    msg_t msg;
+    pid = thread_create(_slow_stack, sizeof(_slow_stack),
+                        THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                        _slow_receiver, (void *)(intptr_t)thread_getpid(),
+                        "slow receiver");
+    msg_receive(&msg);
+    for (unsigned i = 0; i <= QUEUE_SIZE; i++) {
+        msg.type = 0;
+        msg.content.value = i;
+        msg_send(&msg, pid);
+    }
+    printf("blocked sender woken after %u bulk receive(s)\n", _slow_calls);
+    if (_slow_calls != 1) {
+        _failed = 1;
+    }
+
+    puts(_failed ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}
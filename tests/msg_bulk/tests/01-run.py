@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("msg_send_bulk() / msg_receive_bulk() test")
+    for batch in range(4):
+        child.expect_exact("batch {}: delivered 9".format(batch))
+    child.expect(r"sent=36 received=36 wakeups=\d+")
+    child.expect_exact("blocked sender woken after 1 bulk receive(s)")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
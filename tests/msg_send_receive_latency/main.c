@@ -0,0 +1,102 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the round-trip latency of msg_send_receive()
+ *
+ * The server thread is created with a higher, the same and a lower priority
+ * than the client, so all ways through msg_send_receive() and msg_reply()
+ * are covered.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS     (10000U)
+#endif
+
+#define MSG_TYPE_PING   (0x3001)
+#define MSG_TYPE_STOP   (0x3002)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_server(void *arg)
+{
+    (void)arg;
+    msg_t req, resp;
+
+    while (1) {
+        msg_receive(&req);
+        resp.type = req.type;
+        resp.content.value = req.content.value + 1;
+        msg_reply(&req, &resp);
+        if (req.type == MSG_TYPE_STOP) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static int _run(const char *name, uint8_t prio)
+{
+    msg_t req, resp;
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), prio,
+                                     THREAD_CREATE_STACKTEST, _server, NULL,
+                                     "server");
+
+    /* make sure the server is waiting in msg_receive() */
+    thread_yield();
+
+    req.type = MSG_TYPE_PING;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        req.content.value = i;
+        msg_send_receive(&req, &resp, pid);
+        if (resp.content.value != (i + 1)) {
+            printf("%s: wrong reply %lu\n", name,
+                   (unsigned long)resp.content.value);
+            return -1;
+        }
+    }
+    uint32_t diff = xtimer_now_usec() - start;
+
+    req.type = MSG_TYPE_STOP;
+    msg_send_receive(&req, &resp, pid);
+    /* let a server of the same or lower priority terminate */
+    while (thread_getstatus(pid) != STATUS_NOT_FOUND) {
+        xtimer_usleep(1000);
+    }
+
+    printf("server %s: rounds=%u round-trip=%lu ns\n", name, TEST_ROUNDS,
+           (unsigned long)(((uint64_t)diff * 1000) / TEST_ROUNDS));
+    return 0;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("msg_send_receive() latency test");
+
+    res |= _run("higher", THREAD_PRIORITY_MAIN - 1);
+    res |= _run("same", THREAD_PRIORITY_MAIN);
+    res |= _run("lower", THREAD_PRIORITY_MAIN + 1);
+
+    puts((res == 0) ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
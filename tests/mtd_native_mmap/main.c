@@ -0,0 +1,162 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the NOR flash behaviour of the native mtd device with
+ *              module `mtd_native_mmap`
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "board.h"
+#include "embUnit.h"
+#include "mtd.h"
+#include "mtd_native.h"
+
+#define SECTOR_SIZE     (MTD_0->pages_per_sector * MTD_0->page_size)
+#define FLASH_SIZE      (MTD_0->sector_count * SECTOR_SIZE)
+#define SECTOR_SIZE_MAX (4096U)
+
+static uint8_t _buf[SECTOR_SIZE_MAX];
+
+static void _assert_erased(uint32_t addr, uint32_t size)
+{
+    memset(_buf, 0, size);
+    TEST_ASSERT_EQUAL_INT(size, mtd_read(MTD_0, _buf, addr, size));
+    for (uint32_t i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, _buf[i]);
+    }
+}
+
+static void set_up(void)
+{
+    /* fails with -EIO before the flash is initialized */
+    mtd_erase(MTD_0, 0, FLASH_SIZE);
+}
+
+static void test_access__before_init(void)
+{
+    const uint8_t data[] = { 0x00 };
+
+    TEST_ASSERT_EQUAL_INT(-EIO, mtd_write(MTD_0, data, 0, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(-EIO, mtd_read(MTD_0, _buf, 0, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(-EIO, mtd_erase(MTD_0, 0, SECTOR_SIZE));
+}
+
+static void test_init(void)
+{
+    TEST_ASSERT(SECTOR_SIZE <= SECTOR_SIZE_MAX);
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(MTD_0));
+    /* initializing again keeps the mapping */
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(MTD_0));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(MTD_0, 0, FLASH_SIZE));
+    for (uint32_t addr = 0; addr < FLASH_SIZE; addr += SECTOR_SIZE) {
+        _assert_erased(addr, SECTOR_SIZE);
+    }
+}
+
+static void test_write__clears_bits_only(void)
+{
+    const uint8_t first[] = { 0xee, 0xdd, 0xcc, 0x00 };
+    const uint8_t second[] = { 0x33, 0x33, 0x33, 0xff };
+    const uint8_t expected[] = { 0x22, 0x11, 0x00, 0x00 };
+    uint8_t data[sizeof(expected)];
+
+    TEST_ASSERT_EQUAL_INT(sizeof(first), mtd_write(MTD_0, first, 0, sizeof(first)));
+    TEST_ASSERT_EQUAL_INT(sizeof(second), mtd_write(MTD_0, second, 0, sizeof(second)));
+    TEST_ASSERT_EQUAL_INT(sizeof(data), mtd_read(MTD_0, data, 0, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, data, sizeof(expected)));
+    /* programming 0xff changes nothing */
+    memset(_buf, 0xff, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(sizeof(expected), mtd_write(MTD_0, _buf, 0, sizeof(expected)));
+    TEST_ASSERT_EQUAL_INT(sizeof(data), mtd_read(MTD_0, data, 0, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, data, sizeof(expected)));
+    /* the rest of the sector stays erased */
+    _assert_erased(sizeof(expected), SECTOR_SIZE - sizeof(expected));
+}
+
+static void test_erase__sets_bits(void)
+{
+    memset(_buf, 0, SECTOR_SIZE);
+    TEST_ASSERT_EQUAL_INT(SECTOR_SIZE, mtd_write(MTD_0, _buf, SECTOR_SIZE,
+                                                 SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(MTD_0, SECTOR_SIZE, SECTOR_SIZE));
+    _assert_erased(SECTOR_SIZE, SECTOR_SIZE);
+    /* only whole sectors can be erased */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(MTD_0, 0, SECTOR_SIZE / 2));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(MTD_0, MTD_0->page_size,
+                                                SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(MTD_0, FLASH_SIZE, SECTOR_SIZE));
+}
+
+static void test_write__out_of_bounds(void)
+{
+    const uint8_t data[] = { 0x00, 0x00 };
+
+    /* a write must not cross a sector border */
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(MTD_0, data, SECTOR_SIZE - 1,
+                                                sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(MTD_0, data, FLASH_SIZE - 1,
+                                                sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_read(MTD_0, _buf, FLASH_SIZE - 1,
+                                               sizeof(data)));
+    _assert_erased(SECTOR_SIZE - 1, sizeof(data));
+}
+
+static void test_init__shared_file(void)
+{
+    mtd_native_dev_t *native = (mtd_native_dev_t *)MTD_0;
+    mtd_native_dev_t other = {
+        .dev = *MTD_0,
+        .fname = native->fname,
+    };
+    const uint8_t data[] = { 0x5a, 0xa5 };
+    const uint8_t mask[] = { 0x0f, 0xf0 };
+    const uint8_t expected[] = { 0x0a, 0xa0 };
+    uint8_t read[sizeof(data)];
+
+    /* a second device on the same file sees the writes of the first */
+    TEST_ASSERT_EQUAL_INT(sizeof(data), mtd_write(MTD_0, data, 0, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(&other.dev));
+    TEST_ASSERT_EQUAL_INT(sizeof(read), mtd_read(&other.dev, read, 0, sizeof(read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, read, sizeof(data)));
+    /* and the other way round, with the same semantics */
+    TEST_ASSERT_EQUAL_INT(sizeof(mask), mtd_write(&other.dev, mask, 0, sizeof(mask)));
+    TEST_ASSERT_EQUAL_INT(sizeof(read), mtd_read(MTD_0, read, 0, sizeof(read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, read, sizeof(expected)));
+}
+
+static Test *tests_mtd_native_mmap(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_access__before_init),
+        new_TestFixture(test_init),
+        new_TestFixture(test_write__clears_bits_only),
+        new_TestFixture(test_erase__sets_bits),
+        new_TestFixture(test_write__out_of_bounds),
+        new_TestFixture(test_init__shared_file),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_native_mmap());
+    TESTS_END();
+
+    return 0;
+}
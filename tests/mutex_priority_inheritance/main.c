@@ -0,0 +1,188 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures how long a high priority thread waits for a mutex
+ *              held by a low priority thread while a medium priority thread
+ *              hogs the CPU
+ *
+ * Without priority inheritance, the wait time of the high priority thread
+ * includes the bursts of the medium priority thread. With module
+ * `core_mutex_priority_inheritance`, it is bounded by the critical section of
+ * the low priority thread.
+ *
+ * Before that, it checks the priority of a thread that unlocks two mutexes
+ * other threads wait on in the order it locked them.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (200U)
+#endif
+
+/* time the low priority thread holds the mutex */
+#define CRITICAL_US         (200U)
+/* time the medium priority thread hogs the CPU at once */
+#define BURST_US            (5000U)
+
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+static char _stack_waiter[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _mutex = MUTEX_INIT;
+static mutex_t _mutex_a = MUTEX_INIT;
+static mutex_t _mutex_b = MUTEX_INIT;
+static uint32_t _latency[TEST_ROUNDS];
+static uint8_t _prio[2];
+
+static void _busy(uint32_t usec)
+{
+    uint32_t start = xtimer_now_usec();
+    while ((xtimer_now_usec() - start) < usec) {}
+}
+
+static void *_holder(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&_mutex_a);
+    mutex_lock(&_mutex_b);
+    thread_sleep();
+    mutex_unlock(&_mutex_a);
+    _prio[0] = sched_active_thread->priority;
+    mutex_unlock(&_mutex_b);
+    _prio[1] = sched_active_thread->priority;
+
+    return NULL;
+}
+
+static void *_waiter(void *arg)
+{
+    mutex_t *mutex = arg;
+
+    mutex_lock(mutex);
+    mutex_unlock(mutex);
+
+    return NULL;
+}
+
+static int _test_nested(void)
+{
+    kernel_pid_t holder;
+
+    holder = thread_create(_stack_low, sizeof(_stack_low),
+                           THREAD_PRIORITY_MAIN + 3, THREAD_CREATE_STACKTEST,
+                           _holder, NULL, "holder");
+    xtimer_usleep(1000);
+    thread_create(_stack_mid, sizeof(_stack_mid), THREAD_PRIORITY_MAIN + 2,
+                  THREAD_CREATE_STACKTEST, _waiter, &_mutex_a, "waiter a");
+    thread_create(_stack_waiter, sizeof(_stack_waiter),
+                  THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST, _waiter,
+                  &_mutex_b, "waiter b");
+    xtimer_usleep(1000);
+    thread_wakeup(holder);
+    xtimer_usleep(1000);
+
+    /* still waited on by "waiter b" after unlocking the first mutex */
+    printf("holder priority after unlocking: %u, %u (expected %u, %u)\n",
+           (unsigned)_prio[0], (unsigned)_prio[1],
+           (unsigned)(THREAD_PRIORITY_MAIN + 1),
+           (unsigned)(THREAD_PRIORITY_MAIN + 3));
+    return (_prio[0] == (THREAD_PRIORITY_MAIN + 1)) &&
+           (_prio[1] == (THREAD_PRIORITY_MAIN + 3));
+}
+
+static void *_low(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        mutex_lock(&_mutex);
+        _busy(CRITICAL_US);
+        mutex_unlock(&_mutex);
+        xtimer_usleep(300);
+    }
+
+    return NULL;
+}
+
+static void *_mid(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        xtimer_usleep(2 * BURST_US);
+        _busy(BURST_US);
+    }
+
+    return NULL;
+}
+
+static void _sort(uint32_t *values, unsigned numof)
+{
+    for (unsigned i = 1; i < numof; i++) {
+        uint32_t v = values[i];
+        unsigned j = i;
+        while ((j > 0) && (values[j - 1] > v)) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+}
+
+int main(void)
+{
+    puts("mutex priority inheritance latency test");
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    if (!_test_nested()) {
+        puts("[FAILED]");
+        return 1;
+    }
+#endif
+
+    /* main is the high priority thread */
+    thread_create(_stack_low, sizeof(_stack_low), THREAD_PRIORITY_MAIN + 2,
+                  THREAD_CREATE_STACKTEST, _low, NULL, "low");
+    thread_create(_stack_mid, sizeof(_stack_mid), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, _mid, NULL, "mid");
+
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        /* spread the lock attempts over the low thread's cycle */
+        xtimer_usleep(1000 + ((i * 37) % 500));
+        uint32_t start = xtimer_now_usec();
+        mutex_lock(&_mutex);
+        _latency[i] = xtimer_now_usec() - start;
+        mutex_unlock(&_mutex);
+    }
+
+    _sort(_latency, TEST_ROUNDS);
+    uint32_t max = _latency[TEST_ROUNDS - 1];
+    printf("rounds=%u p50=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " (us)\n",
+           TEST_ROUNDS, _latency[TEST_ROUNDS / 2],
+           _latency[(TEST_ROUNDS * 99) / 100], max);
+
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    puts((max < BURST_US) ? "[SUCCESS]" : "[FAILED]");
+#else
+    puts("[SUCCESS]");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("mutex priority inheritance latency test")
+    child.expect(r"holder priority after unlocking: (\d+), (\d+) "
+                 r"\(expected (\d+), (\d+)\)")
+    assert child.match.group(1) == child.match.group(3)
+    assert child.match.group(2) == child.match.group(4)
+    child.expect(r"rounds=\d+ p50=\d+ p99=\d+ max=\d+ \(us\)")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
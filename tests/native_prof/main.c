@@ -0,0 +1,78 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for native's sampling profiler
+ *
+ * Two threads burn CPU in different functions, the second one half as long
+ * as the first one.  The folded stacks sampled meanwhile are printed
+ * afterwards.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "native_prof.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BURN_US             (400U * US_PER_MS)
+
+static char _stacks[2][THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t _sink;
+
+static void __attribute__((noinline)) _work(void)
+{
+    for (unsigned i = 0; i < 1000; i++) {
+        _sink = _sink * 1103515245U + 12345U;
+    }
+}
+
+static void __attribute__((noinline)) _burn(uint32_t duration)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while ((xtimer_now_usec() - start) < duration) {
+        _work();
+    }
+}
+
+static void *_burner_a(void *arg)
+{
+    (void)arg;
+    _burn(BURN_US);
+    return NULL;
+}
+
+static void *_burner_b(void *arg)
+{
+    (void)arg;
+    _burn(BURN_US / 2);
+    return NULL;
+}
+
+int main(void)
+{
+    puts("native_prof test");
+
+    native_prof_reset();
+    /* both run to completion right away */
+    thread_create(_stacks[0], sizeof(_stacks[0]), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _burner_a, NULL, "burner_a");
+    thread_create(_stacks[1], sizeof(_stacks[1]), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _burner_b, NULL, "burner_b");
+
+    puts("folded stacks:");
+    native_prof_dump(NULL);
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import re
+import sys
+
+
+def samples(folded, thread, function):
+    stack = re.compile(r"^{};(\S*;)?{}(;\S+)? (\d+)\s*$".format(thread, function))
+    return sum(int(m.group(3)) for m in map(stack.match, folded) if m)
+
+
+def testfunc(child):
+    child.expect_exact("folded stacks:")
+    child.expect_exact("[SUCCESS]")
+    folded = child.before.splitlines()
+    burned_a = samples(folded, "burner_a", "_burn")
+    burned_b = samples(folded, "burner_b", "_burn")
+    # at ~1 kHz, 400 ms and 200 ms of CPU time
+    assert burned_a > 100, burned_a
+    assert burned_b > 50, burned_b
+    assert burned_a > burned_b
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,71 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for native's virtual time
+ *
+ * Two threads wake up periodically for TEST_DURATION seconds of virtual
+ * time.  With `native_vtime`, the test finishes in a fraction of a second
+ * and the wake-ups are printed in the order of their deadlines.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#define TEST_DURATION       (60U)
+#define SLEEPER_NUMOF       (2U)
+#define FLAG_DONE(num)      (1U << (num))
+
+static const uint32_t _periods[SLEEPER_NUMOF] = { 7, 11 };
+static char _stacks[SLEEPER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static thread_t *_main;
+static uint64_t _start;
+
+static void *_sleeper(void *arg)
+{
+    unsigned num = (unsigned)(uintptr_t)arg;
+    uint32_t period = _periods[num] * US_PER_SEC;
+    xtimer_ticks32_t last = xtimer_now();
+
+    for (uint32_t t = _periods[num]; t < TEST_DURATION; t += _periods[num]) {
+        xtimer_periodic_wakeup(&last, period);
+        uint64_t elapsed = xtimer_now_usec64() - _start;
+        printf("sleeper %u at %lu s\n", num,
+               (unsigned long)((elapsed + US_PER_SEC / 2) / US_PER_SEC));
+    }
+
+    thread_flags_set(_main, FLAG_DONE(num));
+    return NULL;
+}
+
+int main(void)
+{
+    _main = (thread_t *)sched_active_thread;
+    _start = xtimer_now_usec64();
+
+    for (unsigned i = 0; i < SLEEPER_NUMOF; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _sleeper, (void *)(uintptr_t)i,
+                      "sleeper");
+    }
+
+    thread_flags_wait_all(FLAG_DONE(SLEEPER_NUMOF) - 1);
+
+    printf("virtual time elapsed: %lu s\n",
+           (unsigned long)((xtimer_now_usec64() - _start) / US_PER_SEC));
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+DURATION = 60
+PERIODS = (7, 11)
+
+
+def testfunc(child):
+    wakeups = sorted((t, num) for num, period in enumerate(PERIODS)
+                     for t in range(period, DURATION, period))
+    # a minute of virtual time must pass way faster than in real time
+    for t, num in wakeups:
+        child.expect_exact("sleeper {} at {} s".format(num, t), timeout=5)
+    child.expect(r"virtual time elapsed: (\d+) s")
+    assert int(child.match.group(1)) >= wakeups[-1][0]
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
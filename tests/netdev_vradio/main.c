@@ -0,0 +1,38 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the native virtual radio
+ *
+ * Every instance is one node on a medium served by `vradiod`. Frames are
+ * sent with `txtsnd` and the frames received are dumped.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/pktdump.h"
+#include "shell.h"
+#include "shell_commands.h"
+
+int main(void)
+{
+    gnrc_netreg_entry_t dump = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                          gnrc_pktdump_pid);
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    puts("netdev_vradio test application");
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &dump);
+    shell_run(NULL, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+# Starts vradiod with two nodes and a second instance of the application as
+# node 1, then sends frames between node 0 (the instance under test) and
+# node 1 in both directions.
+
+import os
+import signal
+import subprocess
+import sys
+
+import pexpect
+
+VRADIOD_DIR = os.path.join(os.environ['RIOTBASE'], 'dist/tools/vradio')
+MEDIUM = os.environ['VRADIO_MEDIUM']
+
+
+def start_vradiod():
+    subprocess.check_call(['make', '-C', VRADIOD_DIR],
+                          stdout=subprocess.DEVNULL)
+    # without air time pacing, frames are delivered right away
+    daemon = pexpect.spawnu(os.path.join(VRADIOD_DIR, 'bin/vradiod'),
+                            ['-m', MEDIUM, '-n', '2', '-A'], timeout=5)
+    daemon.expect_exact('vradiod: medium {} with 2 nodes ready'.format(MEDIUM))
+    return daemon
+
+
+def get_iface(node):
+    node.sendline('ifconfig')
+    node.expect(r'Iface\s+(\d+)\s+HWaddr: ([0-9a-fA-F:]+)\s')
+    iface, short_addr = int(node.match.group(1)), node.match.group(2)
+    node.expect(r'Long HWaddr: ([0-9a-fA-F:]+)\s')
+    return iface, short_addr, node.match.group(1)
+
+
+def send(sender, receiver, iface, dst, src, payload):
+    sender.sendline('txtsnd {} {} {}'.format(iface, dst, payload))
+    receiver.expect_exact('PKTDUMP: data received:')
+    receiver.expect(r'size:\s+{} byte, type: NETTYPE_UNDEF'.format(len(payload)))
+    receiver.expect(r'00000000' + ''.join(r'\s+{:02X}'.format(ord(c))
+                                          for c in payload))
+    receiver.expect_exact('src_l2addr: {}'.format(src))
+
+
+def testfunc(child):
+    node1 = pexpect.spawnu(os.environ['ELF'], ['-r', '1:' + MEDIUM],
+                           timeout=10)
+    node1.logfile = sys.stdout
+    try:
+        child.expect_exact('netdev_vradio test application')
+        node1.expect_exact('netdev_vradio test application')
+        # frames are sent with the short address as source
+        iface0, short0, addr0 = get_iface(child)
+        iface1, short1, addr1 = get_iface(node1)
+        assert addr0 != addr1
+
+        send(child, node1, iface0, addr1, short0, 'ping0to1')
+        send(node1, child, iface1, addr0, short1, 'pong1to0')
+        send(child, node1, iface0, 'bcast', short0, 'bcast0')
+        # a frame to a third address is filtered by node 1
+        child.sendline('txtsnd {} 02:00:00:00:00:00:00:2a lost'.format(iface0))
+        assert node1.expect_exact(['PKTDUMP: data received:',
+                                   pexpect.TIMEOUT], timeout=1) == 1
+        send(child, node1, iface0, addr1, short0, 'last0to1')
+        print("[SUCCESS]")
+    finally:
+        node1.terminate(force=True)
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    daemon = start_vradiod()
+    try:
+        res = run(testfunc)
+    finally:
+        # vradiod removes the shared memory segment on SIGTERM only
+        daemon.kill(signal.SIGTERM)
+        daemon.expect(pexpect.EOF)
+    sys.exit(res)
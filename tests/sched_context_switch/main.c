@@ -0,0 +1,71 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the context switch rate between two threads
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_DURATION   (2U * US_PER_SEC)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static volatile int _done;
+static volatile uint32_t _switches;
+
+static void _timeout(void *arg)
+{
+    (void)arg;
+    _done = 1;
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        _switches++;
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    xtimer_t timer = { .callback = _timeout };
+
+    printf("context switch benchmark: levels=%u layout=%s\n",
+           (unsigned)SCHED_PRIO_LEVELS,
+           SCHED_PRIO_TWO_LEVEL ? "two-level" : "single");
+
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _thread, NULL, "pong");
+
+    _switches = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_done) {
+        /* every wakeup switches to the pong thread and back */
+        thread_wakeup(pid);
+    }
+
+    printf("switches=%lu per second=%lu\n", (unsigned long)(2 * _switches),
+           (unsigned long)(2 * _switches) / (TEST_DURATION / US_PER_SEC));
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test round-robin scheduling of busy threads of equal priority
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "ps.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define WORKERS         (3U)
+#define TEST_DURATION   (1U * US_PER_SEC)
+
+static char _stacks[WORKERS][THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t _counters[WORKERS];
+
+static void *_worker(void *arg)
+{
+    volatile uint32_t *counter = arg;
+
+    /* never yields */
+    while (1) {
+        (*counter)++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t pids[WORKERS];
+    int failed = 0;
+
+    puts("round-robin test");
+
+    for (unsigned i = 0; i < WORKERS; i++) {
+        pids[i] = thread_create(_stacks[i], sizeof(_stacks[i]),
+                                THREAD_PRIORITY_MAIN + 1,
+                                THREAD_CREATE_STACKTEST, _worker,
+                                (void *)&_counters[i], "worker");
+    }
+
+    xtimer_usleep(TEST_DURATION);
+
+    for (unsigned i = 0; i < WORKERS; i++) {
+        unsigned slices = sched_pidlist[pids[i]].slices;
+        printf("worker %u: count=%lu slices=%u\n", i,
+               (unsigned long)_counters[i], slices);
+        if ((_counters[i] == 0) || (slices == 0)) {
+            failed = 1;
+        }
+    }
+
+    ps();
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Records a short scheduler trace of message ping-pong and
+ *              mutex contention and dumps it
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "sched_trace.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_ROUNDS     (4U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _lock = MUTEX_INIT;
+
+static void *_server(void *arg)
+{
+    (void)arg;
+    msg_t m, reply;
+
+    while (1) {
+        msg_receive(&m);
+        mutex_lock(&_lock);
+        reply.type = m.type + 1;
+        mutex_unlock(&_lock);
+        msg_send(&reply, m.sender_pid);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("scheduler trace test");
+
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST, _server, NULL,
+                                     "server");
+
+    sched_trace_start();
+
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        msg_t m, reply;
+        m.type = i;
+
+        /* hold the lock so the server blocks on it */
+        mutex_lock(&_lock);
+        msg_send(&m, pid);
+        xtimer_usleep(1000);
+        mutex_unlock(&_lock);
+        msg_receive(&reply);
+    }
+
+    sched_trace_stop();
+    sched_trace_dump();
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("scheduler trace test")
+    child.expect(r"trace: start hz=\d+ records=\d+ lost=\d+")
+    child.expect(r"trace: thread \d+ server")
+    child.expect(r"trace: [0-9a-f]{8} \d+ \d+ \d+")
+    child.expect_exact("trace: end")
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
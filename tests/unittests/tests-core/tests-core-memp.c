@@ -0,0 +1,80 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#include "memp.h"
+
+#include "tests-core.h"
+
+#define TEST_MEMP_NUMOF     (4U)
+
+typedef struct {
+    void *ptr;
+    uint16_t value;
+} test_block_t;
+
+static memp_t pool;
+static test_block_t blocks[TEST_MEMP_NUMOF];
+
+static void set_up(void)
+{
+    memp_init(&pool, "test", blocks, sizeof(test_block_t), TEST_MEMP_NUMOF);
+}
+
+static void test_memp_alloc_all(void)
+{
+    test_block_t *b[TEST_MEMP_NUMOF];
+
+    for (unsigned i = 0; i < TEST_MEMP_NUMOF; i++) {
+        b[i] = memp_alloc(&pool);
+        TEST_ASSERT_NOT_NULL(b[i]);
+        TEST_ASSERT(b[i] >= &blocks[0]);
+        TEST_ASSERT(b[i] <= &blocks[TEST_MEMP_NUMOF - 1]);
+        for (unsigned j = 0; j < i; j++) {
+            TEST_ASSERT(b[i] != b[j]);
+        }
+    }
+    TEST_ASSERT_NULL(memp_alloc(&pool));
+    TEST_ASSERT_EQUAL_INT(TEST_MEMP_NUMOF, pool.used);
+    TEST_ASSERT_EQUAL_INT(TEST_MEMP_NUMOF, pool.high_water);
+    TEST_ASSERT_EQUAL_INT(1, pool.failures);
+}
+
+static void test_memp_free_reuse(void)
+{
+    test_block_t *b1 = memp_alloc(&pool);
+    test_block_t *b2 = memp_alloc(&pool);
+
+    memp_free(&pool, b1);
+    TEST_ASSERT_EQUAL_INT(1, pool.used);
+    TEST_ASSERT_EQUAL_INT(2, pool.high_water);
+    TEST_ASSERT(memp_alloc(&pool) == b1);
+    memp_free(&pool, b1);
+    memp_free(&pool, b2);
+    TEST_ASSERT_EQUAL_INT(0, pool.used);
+}
+
+static void test_memp_free_null(void)
+{
+    memp_free(&pool, NULL);
+    TEST_ASSERT_EQUAL_INT(0, pool.used);
+}
+
+Test *tests_core_memp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_memp_alloc_all),
+        new_TestFixture(test_memp_free_reuse),
+        new_TestFixture(test_memp_free_null),
+    };
+
+    EMB_UNIT_TESTCALLER(core_memp_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_memp_tests;
+}
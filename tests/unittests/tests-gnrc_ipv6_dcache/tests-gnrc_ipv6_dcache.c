@@ -0,0 +1,148 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/ipv6/dcache.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/ipv6/addr.h"
+
+#include "tests-gnrc_ipv6_dcache.h"
+
+#define IFACE               (6)
+
+#define DST                 { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01, \
+                                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 } }
+#define NEXT_HOP            { { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                                0x02, 0x00, 0x5e, 0xff, 0xfe, 0x00, 0x53, 0x01 } }
+#define L2ADDR              { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 }
+
+static gnrc_netif_t _netif;
+static gnrc_ipv6_dcache_stats_t _stats;
+static const ipv6_addr_t _dst = DST;
+static const gnrc_ipv6_nib_nc_t _nce = { .ipv6 = NEXT_HOP, .l2addr = L2ADDR,
+                                         .l2addr_len = 6 };
+
+static void set_up(void)
+{
+    gnrc_ipv6_nib_init();
+    gnrc_ipv6_dcache_flush();
+    gnrc_ipv6_dcache_get_stats(&_stats);
+}
+
+static gnrc_ipv6_dcache_entry_t *_add(kernel_pid_t iface)
+{
+    /* entries are only added after a miss */
+    if (gnrc_ipv6_dcache_get(&_dst, iface) != NULL) {
+        return NULL;
+    }
+    return gnrc_ipv6_dcache_add(&_dst, iface, &_netif, &_nce);
+}
+
+static void test_dcache_get__empty(void)
+{
+    gnrc_ipv6_dcache_stats_t stats;
+
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+    gnrc_ipv6_dcache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(_stats.hits, stats.hits);
+    TEST_ASSERT_EQUAL_INT(_stats.misses + 1, stats.misses);
+}
+
+static void test_dcache_add__success(void)
+{
+    gnrc_ipv6_dcache_entry_t *entry;
+    gnrc_ipv6_dcache_stats_t stats;
+
+    TEST_ASSERT_NOT_NULL((entry = _add(KERNEL_PID_UNDEF)));
+    TEST_ASSERT(entry == gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+    TEST_ASSERT(ipv6_addr_equal(&_dst, &entry->dst));
+    TEST_ASSERT(ipv6_addr_equal(&_nce.ipv6, &entry->next_hop));
+    TEST_ASSERT(ipv6_addr_is_unspecified(&entry->src));
+    TEST_ASSERT(&_netif == entry->netif);
+    TEST_ASSERT_EQUAL_INT(_nce.l2addr_len, entry->l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_nce.l2addr, entry->l2addr,
+                                    _nce.l2addr_len));
+    gnrc_ipv6_dcache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(_stats.hits + 1, stats.hits);
+    TEST_ASSERT_EQUAL_INT(_stats.misses + 1, stats.misses);
+}
+
+static void test_dcache_get__other_iface(void)
+{
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, IFACE));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dcache_add(&_dst, IFACE, &_netif, &_nce));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dcache_get(&_dst, IFACE));
+}
+
+static void test_dcache_flush(void)
+{
+    gnrc_ipv6_dcache_stats_t stats;
+
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF));
+    gnrc_ipv6_dcache_flush();
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+    gnrc_ipv6_dcache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(_stats.flushes + 1, stats.flushes);
+}
+
+static void test_dcache_add__flushed_during_lookup(void)
+{
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+    gnrc_ipv6_dcache_flush();
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_add(&_dst, KERNEL_PID_UNDEF, &_netif,
+                                          &_nce));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+}
+
+static void test_dcache_nib_nc_set(void)
+{
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_nce.ipv6, IFACE,
+                                                  _nce.l2addr,
+                                                  _nce.l2addr_len));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+}
+
+static void test_dcache_nib_ft_add(void)
+{
+    TEST_ASSERT_NOT_NULL(_add(KERNEL_PID_UNDEF));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(NULL, 0, &_nce.ipv6, IFACE,
+                                                  0));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(&_dst, KERNEL_PID_UNDEF));
+}
+
+static Test *tests_gnrc_ipv6_dcache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_dcache_get__empty),
+        new_TestFixture(test_dcache_add__success),
+        new_TestFixture(test_dcache_get__other_iface),
+        new_TestFixture(test_dcache_flush),
+        new_TestFixture(test_dcache_add__flushed_during_lookup),
+        new_TestFixture(test_dcache_nib_nc_set),
+        new_TestFixture(test_dcache_nib_ft_add),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_dcache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_ipv6_dcache_tests;
+}
+
+void tests_gnrc_ipv6_dcache(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_dcache_tests());
+}
+/** @} */
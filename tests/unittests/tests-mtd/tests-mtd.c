@@ -239,6 +239,37 @@ static void test_mtd_write_read_flash(void)
 }
 #endif
 
+#ifdef MODULE_MTD_NATIVE
+static void test_mtd_native_stats(void)
+{
+    mtd_native_dev_t *native = (mtd_native_dev_t *)dev;
+    uint32_t sector_size = dev->pages_per_sector * dev->page_size;
+    const uint8_t buf[] = {0x11, 0x22, 0x33, 0x44};
+    uint8_t buf_read[sizeof(buf)];
+
+    mtd_native_stats_reset(native);
+
+    /* read across the border of sector 0 and 1 */
+    int ret = mtd_read(dev, buf_read, sector_size - 2, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), ret);
+    ret = mtd_write(dev, buf, sector_size, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    ret = mtd_erase(dev, 0, 2 * sector_size);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+
+    TEST_ASSERT(native->stats.read_bytes == sizeof(buf_read));
+    TEST_ASSERT(native->stats.program_bytes == sizeof(buf));
+    TEST_ASSERT(native->stats.erase_bytes == 2 * sector_size);
+    TEST_ASSERT_EQUAL_INT(1, native->stats.sectors[0].reads);
+    TEST_ASSERT_EQUAL_INT(0, native->stats.sectors[0].programs);
+    TEST_ASSERT_EQUAL_INT(1, native->stats.sectors[0].erases);
+    TEST_ASSERT_EQUAL_INT(1, native->stats.sectors[1].reads);
+    TEST_ASSERT_EQUAL_INT(1, native->stats.sectors[1].programs);
+    TEST_ASSERT_EQUAL_INT(1, native->stats.sectors[1].erases);
+    TEST_ASSERT_EQUAL_INT(0, native->stats.sectors[2].erases);
+}
+#endif
+
 #if MODULE_VFS
 static void test_mtd_vfs(void)
 {
@@ -278,6 +309,9 @@ Test *tests_mtd_tests(void)
 #ifdef MTD_0
         new_TestFixture(test_mtd_write_read_flash),
 #endif
+#ifdef MODULE_MTD_NATIVE
+        new_TestFixture(test_mtd_native_stats),
+#endif
 #if MODULE_VFS
         new_TestFixture(test_mtd_vfs),
 #endif
@@ -139,6 +139,31 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_getnext__interleaved(void)
+{
+    gnrc_netreg_entry_t others[] = {
+        GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1, TEST_UINT8),
+        GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16 + 1, TEST_UINT8 + 1)
+    };
+    gnrc_netreg_entry_t *res;
+    int num = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &others[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &others[1]));
+    for (res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16); res != NULL;
+         res = gnrc_netreg_getnext(res)) {
+        TEST_ASSERT_EQUAL_INT(TEST_UINT16, res->demux_ctx);
+        num++;
+    }
+    TEST_ASSERT_EQUAL_INT(2, num);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + 1));
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &others[0]);
+    gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &others[1]);
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +180,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_getnext__interleaved),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -14,6 +14,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/uio.h>
 
 #include "embUnit.h"
@@ -202,6 +203,7 @@ static void test_pktbuf_add__memfull(void)
 }
 #endif
 
+#ifndef MODULE_GNRC_PKTBUF_SLAB     /* only GNRC_PKTBUF_SLAB_LARGE_NUMOF payloads of that size */
 static void test_pktbuf_add__success(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
@@ -225,6 +227,7 @@ static void test_pktbuf_add__success(void)
     }
     TEST_ASSERT(gnrc_pktbuf_is_sane());
 }
+#endif
 
 static void test_pktbuf_add__packed_struct(void)
 {
@@ -245,7 +248,9 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC   /* alignment-handling left to malloc, so no certainty here */
+/* alignment-handling left to malloc, so no certainty here; slab blocks are
+ * reused as a whole */
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -321,7 +326,8 @@ static void test_pktbuf_mark__pkt_NOT_NULL__size_greater_than_pkt_size(void)
 
 static void test_pktbuf_mark__pkt_NOT_NULL__pkt_data_NULL(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, NULL, sizeof(TEST_STRING16), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .size = sizeof(TEST_STRING16),
+                           .type = GNRC_NETTYPE_TEST };
 
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(&pkt, sizeof(TEST_STRING16) - 1,
                                       GNRC_NETTYPE_TEST));
@@ -661,7 +667,8 @@ static void test_pktbuf_hold__pkt_null(void)
 
 static void test_pktbuf_hold__pkt_external(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .data = TEST_STRING8,
+                           .size = sizeof(TEST_STRING8), .type = GNRC_NETTYPE_TEST };
 
     gnrc_pktbuf_hold(&pkt, 1);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -818,6 +825,122 @@ static void test_pktbuf_get_iovec__null(void)
     TEST_ASSERT_EQUAL_INT(0, len);
 }
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+static void test_pktbuf_slab__no_fragmentation(void)
+{
+    gnrc_pktsnip_t *small[GNRC_PKTBUF_SLAB_SMALL_NUMOF / 2];
+    gnrc_pktsnip_t *large[GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+    for (unsigned i = 0; i < (GNRC_PKTBUF_SLAB_SMALL_NUMOF / 2); i++) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
+
+        small[i] = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(tmp);
+        TEST_ASSERT_NOT_NULL(small[i]);
+        gnrc_pktbuf_release(tmp);
+    }
+    /* the holes between the small payloads do not keep large ones out */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_LARGE_NUMOF; i++) {
+        large[i] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE,
+                                   GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(large[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < (GNRC_PKTBUF_SLAB_SMALL_NUMOF / 2); i++) {
+        gnrc_pktbuf_release(small[i]);
+    }
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_LARGE_NUMOF; i++) {
+        gnrc_pktbuf_release(large[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab__add_too_large(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab__mark_in_place(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING64, sizeof(TEST_STRING64),
+                                          GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *marked;
+    uint8_t *data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    marked = gnrc_pktbuf_mark(pkt, 8, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(marked);
+    /* the remainder is not copied */
+    TEST_ASSERT(data + 8 == pkt->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING64) - 8, pkt->size);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING64 + 8, pkt->data);
+    TEST_ASSERT_EQUAL_INT(8, marked->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING64, marked->data, 8));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab__frames_next_to_payloads(void)
+{
+    gnrc_pktsnip_t *frames[GNRC_PKTBUF_SLAB_FRAME_NUMOF];
+    gnrc_pktsnip_t *large[GNRC_PKTBUF_SLAB_LARGE_NUMOF];
+
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_LARGE_NUMOF; i++) {
+        large[i] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_LARGE_SIZE,
+                                   GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(large[i]);
+    }
+    /* frames do not take blocks of the payload slab */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_FRAME_NUMOF; i++) {
+        frames[i] = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_FRAME_SIZE,
+                                    GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(frames[i]);
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_FRAME_SIZE,
+                                     GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_FRAME_NUMOF; i++) {
+        gnrc_pktbuf_release(frames[i]);
+    }
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_LARGE_NUMOF; i++) {
+        gnrc_pktbuf_release(large[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_slab__realloc_data__grow_in_place(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_SMALL_SIZE + 1,
+                                          GNRC_NETTYPE_TEST);
+    void *data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_FRAME_SIZE));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_FRAME_SIZE, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    pkt = gnrc_pktbuf_add(NULL, NULL, GNRC_PKTBUF_SLAB_FRAME_SIZE + 1,
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    data = pkt->data;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, GNRC_PKTBUF_SLAB_LARGE_SIZE));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_SLAB_LARGE_SIZE, pkt->size);
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_realloc_data(pkt,
+                                                           GNRC_PKTBUF_SLAB_LARGE_SIZE + 1));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -832,9 +955,11 @@ Test *tests_pktbuf_tests(void)
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_add__memfull),
 #endif
+#ifndef MODULE_GNRC_PKTBUF_SLAB
         new_TestFixture(test_pktbuf_add__success),
+#endif
         new_TestFixture(test_pktbuf_add__packed_struct),
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if !defined(MODULE_GNRC_PKTBUF_MALLOC) && !defined(MODULE_GNRC_PKTBUF_SLAB)
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
 #endif
         new_TestFixture(test_pktbuf_add__0_sized_release),
@@ -870,6 +995,13 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+        new_TestFixture(test_pktbuf_slab__no_fragmentation),
+        new_TestFixture(test_pktbuf_slab__add_too_large),
+        new_TestFixture(test_pktbuf_slab__mark_in_place),
+        new_TestFixture(test_pktbuf_slab__frames_next_to_payloads),
+        new_TestFixture(test_pktbuf_slab__realloc_data__grow_in_place),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
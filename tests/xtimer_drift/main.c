@@ -33,6 +33,10 @@
 #include "msg.h"
 #include "log.h"
 
+#ifdef MODULE_NATIVE_HRTIMER
+#include "periph_cpu.h"
+#endif
+
 /* We generate some context switching and IPC traffic by using multiple threads
  * and generate some xtimer load by scheduling several messages to be called at
  * different times. TEST_HZ is the frequency of messages being sent from the
@@ -119,6 +123,14 @@ void *worker_thread(void *arg)
                     sec, us, ticks.ticks32);
             printf("drift=%" PRId32 " us, jitter=%" PRId32 " us\n",
                     drift, jitter);
+#ifdef MODULE_NATIVE_HRTIMER
+            native_timer_jitter_t timer;
+            native_timer_jitter(&timer, true);
+            printf("timer jitter: wakeups=%" PRIu32 " avg=%" PRIu32 " ns "
+                   "max=%" PRIu32 " ns\n", timer.count,
+                   timer.count ? (uint32_t)(timer.sum / timer.count) : 0,
+                   timer.max);
+#endif
             last = now;
         }
         ++loop_counter;
@@ -0,0 +1,136 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the interrupts-disabled time of xtimer_set() and
+ *              xtimer_remove() depending on the number of active timers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#ifndef TEST_MAX_TIMERS
+#define TEST_MAX_TIMERS     (256U)
+#endif
+
+#ifndef TEST_REPETITIONS
+#define TEST_REPETITIONS    (256U)
+#endif
+
+#define TEST_MIN_OFFSET     (1U * US_PER_SEC)
+#define TEST_MAX_OFFSET     (60U * US_PER_SEC)
+
+typedef struct {
+    uint32_t sum;
+    uint32_t max;
+} stat_t;
+
+static xtimer_t _timers[TEST_MAX_TIMERS + 1];
+static uint32_t _seed = 1;
+
+static uint32_t _rand(void)
+{
+    /* simple LCG, good enough to spread the timers */
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+static uint32_t _rand_offset(void)
+{
+    return TEST_MIN_OFFSET + (_rand() % (TEST_MAX_OFFSET - TEST_MIN_OFFSET));
+}
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired");
+}
+
+static void _record(stat_t *stat, uint32_t start)
+{
+    uint32_t diff = xtimer_now().ticks32 - start;
+
+    stat->sum += diff;
+    if (diff > stat->max) {
+        stat->max = diff;
+    }
+}
+
+static void _print(const char *name, stat_t *stat)
+{
+    printf(" %s: avg=%" PRIu32 " max=%" PRIu32,
+           name, stat->sum / TEST_REPETITIONS, stat->max);
+}
+
+static void _run(unsigned numof)
+{
+    stat_t set = { 0, 0 }, set_last = { 0, 0 }, remove = { 0, 0 };
+    xtimer_t *last = &_timers[TEST_MAX_TIMERS];
+
+    for (unsigned i = 0; i < numof; i++) {
+        xtimer_set(&_timers[i], _rand_offset());
+    }
+
+    for (unsigned i = 0; i < TEST_REPETITIONS; i++) {
+        xtimer_t *timer = &_timers[_rand() % numof];
+        uint32_t offset = _rand_offset();
+        uint32_t start = xtimer_now().ticks32;
+        xtimer_set(timer, offset);
+        _record(&set, start);
+
+        offset = TEST_MAX_OFFSET + (i % 2);
+        start = xtimer_now().ticks32;
+        xtimer_set(last, offset);
+        _record(&set_last, start);
+        xtimer_remove(last);
+
+        timer = &_timers[_rand() % numof];
+        start = xtimer_now().ticks32;
+        xtimer_remove(timer);
+        _record(&remove, start);
+        xtimer_set(timer, _rand_offset());
+    }
+
+    for (unsigned i = 0; i < numof; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+
+    printf("timers=%u", numof);
+    _print("set", &set);
+    _print("set_last", &set_last);
+    _print("remove", &remove);
+    puts(" (ticks)");
+}
+
+int main(void)
+{
+    puts("xtimer IRQ-off benchmark");
+#ifdef MODULE_XTIMER_WHEEL
+    puts("backend: timing wheel");
+#else
+    puts("backend: sorted lists");
+#endif
+
+    for (unsigned i = 0; i <= TEST_MAX_TIMERS; i++) {
+        _timers[i].callback = _cb;
+    }
+
+    for (unsigned numof = 1; numof <= TEST_MAX_TIMERS; numof *= 2) {
+        _run(numof);
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
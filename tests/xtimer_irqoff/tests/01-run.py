@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("xtimer IRQ-off benchmark")
+    child.expect(r"backend: [\w ]+")
+    for numof in [1, 2, 4, 8, 16, 32, 64, 128, 256]:
+        child.expect(r"timers={} set: avg=\d+ max=\d+ set_last: avg=\d+ "
+                     r"max=\d+ remove: avg=\d+ max=\d+ \(ticks\)".format(numof))
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc, timeout=120))
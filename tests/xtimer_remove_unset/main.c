@@ -0,0 +1,107 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test removing timers that are not set
+ *
+ * Timers on the stack are commonly removed before ever being set, so
+ * xtimer_remove() must leave pending timers alone when given a timer that
+ * holds garbage, that already fired or that is a copy of a pending one.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define NUMOF       (2U)
+#define TIMEOUT     (100000U)
+
+static kernel_pid_t _me;
+
+static void _set(xtimer_t *timers, msg_t *msg)
+{
+    for (unsigned int i = 0; i < NUMOF; i++) {
+        msg[i].type = i;
+        xtimer_set_msg(&timers[i], TIMEOUT * (i + 1), &msg[i], _me);
+    }
+}
+
+static int _expect(void)
+{
+    for (unsigned int i = 0; i < NUMOF; i++) {
+        msg_t m;
+
+        if (xtimer_msg_receive_timeout(&m, 4 * TIMEOUT) < 0) {
+            puts("ERROR: timer did not trigger");
+            return -1;
+        }
+        printf("timer %u triggered.\n", m.type);
+    }
+    return 0;
+}
+
+int main(void)
+{
+    xtimer_t timers[NUMOF];
+    msg_t msg[NUMOF];
+
+    puts("xtimer_remove_unset test application.");
+
+    _me = thread_getpid();
+
+    puts("Setting 2 timers, removing a garbage-filled timer");
+    {
+        xtimer_t unset;
+
+        memset(&unset, 0x55, sizeof(unset));
+        _set(timers, msg);
+        xtimer_remove(&unset);
+        if (_expect() < 0) {
+            return -1;
+        }
+    }
+
+    puts("Setting 2 timers, removing a fired timer");
+    {
+        xtimer_t fired;
+        msg_t m, fired_msg = { .type = NUMOF };
+
+        memset(&fired, 0, sizeof(fired));
+        xtimer_set_msg(&fired, TIMEOUT / 2, &fired_msg, _me);
+        msg_receive(&m);
+        _set(timers, msg);
+        xtimer_remove(&fired);
+        xtimer_remove(&fired);
+        if (_expect() < 0) {
+            return -1;
+        }
+    }
+
+    puts("Setting 2 timers, removing a copy of timer 0");
+    {
+        xtimer_t copy;
+
+        _set(timers, msg);
+        memcpy(&copy, &timers[0], sizeof(copy));
+        xtimer_remove(&copy);
+        if (_expect() < 0) {
+            return -1;
+        }
+    }
+
+    puts("test successful.");
+
+    return 0;
+}
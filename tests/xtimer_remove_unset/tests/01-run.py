@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("xtimer_remove_unset test application.")
+    for case in ("a garbage-filled timer", "a fired timer", "a copy of timer 0"):
+        child.expect_exact("Setting 2 timers, removing {}".format(case))
+        child.expect_exact("timer 0 triggered.")
+        child.expect_exact("timer 1 triggered.")
+    child.expect_exact("test successful.")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -0,0 +1,98 @@
+/*
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Counts how many wakeups xtimer_set_slack() saves for a set of
+ *              periodic timers with overlapping deadlines
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+#include "thread.h"
+#include "msg.h"
+
+#ifndef TEST_TIMERS
+#define TEST_TIMERS         (8U)
+#endif
+
+#define TEST_PERIOD         (10U * US_PER_MS)
+#define TEST_SLACK          (5U * US_PER_MS)
+#define TEST_RUNS           (100U)
+
+static xtimer_t _timers[TEST_TIMERS];
+static msg_t _msgs[TEST_TIMERS];
+static uint32_t _periods[TEST_TIMERS];
+
+static int _run(uint32_t slack)
+{
+    xtimer_stats_t before, after;
+    unsigned fired = 0;
+    uint32_t max_late = 0;
+
+    xtimer_get_stats(&before);
+
+    for (unsigned i = 0; i < TEST_TIMERS; i++) {
+        /* spread the periods so that the deadlines drift against each other */
+        _periods[i] = TEST_PERIOD + (i * 700U);
+        _msgs[i].type = i;
+        _msgs[i].content.value = xtimer_now_usec() + _periods[i];
+        xtimer_set_msg_slack(&_timers[i], _periods[i], slack,
+                             &_msgs[i], thread_getpid());
+    }
+
+    while (fired < (TEST_TIMERS * TEST_RUNS)) {
+        msg_t m;
+        msg_receive(&m);
+        uint32_t now = xtimer_now_usec();
+        uint32_t late = now - m.content.value;
+        if (late > max_late) {
+            max_late = late;
+        }
+
+        unsigned i = m.type;
+        fired++;
+        if (fired <= (TEST_TIMERS * (TEST_RUNS - 1))) {
+            _msgs[i].content.value = now + _periods[i];
+            xtimer_set_msg_slack(&_timers[i], _periods[i], slack,
+                                 &_msgs[i], thread_getpid());
+        }
+    }
+
+    xtimer_get_stats(&after);
+
+    printf("slack=%" PRIu32 " fired=%u wakeups=%" PRIu32 " merged=%" PRIu32
+           " max_late=%" PRIu32 "\n", slack, fired,
+           after.wakeups - before.wakeups, after.merged - before.merged,
+           max_late);
+
+    /* allow some scheduling jitter on top of the requested slack */
+    return (max_late <= slack + (2U * US_PER_MS)) ? 0 : -1;
+}
+
+int main(void)
+{
+    static msg_t queue[TEST_TIMERS];
+    int res = 0;
+
+    msg_init_queue(queue, TEST_TIMERS);
+
+    puts("xtimer slack test");
+
+    res |= _run(0);
+    res |= _run(TEST_SLACK);
+
+    puts((res == 0) ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+
+def testfunc(child):
+    child.expect_exact("xtimer slack test")
+    child.expect(r"slack=0 fired=800 wakeups=(\d+) merged=\d+ max_late=\d+")
+    wakeups_strict = int(child.match.group(1))
+    child.expect(r"slack=\d+ fired=800 wakeups=(\d+) merged=\d+ max_late=\d+")
+    wakeups_slack = int(child.match.group(1))
+    assert wakeups_slack < wakeups_strict
+    child.expect_exact("[SUCCESS]")
+
+
+if __name__ == "__main__":
+    sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+    from testrunner import run
+    sys.exit(run(testfunc))
@@ -19,6 +19,10 @@
 #include <stdio.h>
 #include "xtimer.h"
 
+#ifdef MODULE_NATIVE_HRTIMER
+#include "periph_cpu.h"
+#endif
+
 #define TEST_USLEEP_MIN (0)
 #define TEST_USLEEP_MAX (500)
 
@@ -33,6 +37,15 @@ int main(void)
         xtimer_usleep(i);
     }
 
+#ifdef MODULE_NATIVE_HRTIMER
+    native_timer_jitter_t jitter;
+    native_timer_jitter(&jitter, false);
+    printf("timer jitter: wakeups=%lu avg=%lu ns max=%lu ns\n",
+           (unsigned long)jitter.count,
+           (unsigned long)(jitter.count ? jitter.sum / jitter.count : 0),
+           (unsigned long)jitter.max);
+#endif
+
     puts("[SUCCESS]");
 
     return 0;